@@ -0,0 +1,189 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/Operator.h"
+#include <QRandomGenerator>
+#include <benchmark/benchmark.h>
+
+namespace {
+// The size of the sample randomTestDecomposition checks
+const int COUNT_OF_OPERATORS = 10000;
+
+// Drawn like randomTestDecomposition does, but from a seeded generator, so every run of the
+// suite decomposes the same operators
+QVector<UnitaryMatrix2x2> randomOperators() {
+    QRandomGenerator          seeds(1);
+    QVector<UnitaryMatrix2x2> ops;
+    for (int k = 0; k < COUNT_OF_OPERATORS; ++k) {
+        ops.append(Operator::genRandUnitaryMatrix(seeds.generate64()));
+    }
+    return ops;
+}
+
+const QVector<UnitaryMatrix2x2> &operators() {
+    static const QVector<UnitaryMatrix2x2> ops = randomOperators();
+    return ops;
+}
+
+void benchDecomposition(benchmark::State &state, decomposition (*getDec)(UnitaryMatrix2x2)) {
+    const QVector<UnitaryMatrix2x2> &ops = operators();
+    DecompositionKernel::setEngine(static_cast<DecompositionKernel::ENGINE>(state.range(0)));
+    int k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getDec(ops[k]));
+        k = (k + 1) % COUNT_OF_OPERATORS;
+    }
+    DecompositionKernel::setEngine(DecompositionKernel::LEGACY);
+    state.SetItemsProcessed(state.iterations());
+}
+
+void benchMatrixByDec(benchmark::State &state, decomposition (*getDec)(UnitaryMatrix2x2),
+                      matrix2x2 (*getMatrix)(decomposition)) {
+    QVector<decomposition> decs;
+    for (auto &op : operators()) {
+        decs.append(getDec(op));
+    }
+    int k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(getMatrix(decs[k]));
+        k = (k + 1) % COUNT_OF_OPERATORS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+} // namespace
+
+static void BM_UnitaryMatrixMultiply(benchmark::State &state) {
+    const QVector<UnitaryMatrix2x2> &ops = operators();
+    UnitaryMatrix2x2                 op = ops[0];
+    int                              k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(op * ops[k]);
+        k = (k + 1) % COUNT_OF_OPERATORS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_UnitaryMatrixMultiply);
+
+static void BM_IsUnitaryMatrix(benchmark::State &state) {
+    const QVector<UnitaryMatrix2x2> &ops = operators();
+    int                              k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UnitaryMatrix2x2::isUnitaryMatrix(ops[k]));
+        k = (k + 1) % COUNT_OF_OPERATORS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IsUnitaryMatrix);
+
+static void BM_CompareOperators(benchmark::State &state) {
+    const QVector<UnitaryMatrix2x2> &ops = operators();
+    int                              k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(UnitaryMatrix2x2::compareOperators(ops[k], ops[k], false));
+        k = (k + 1) % COUNT_OF_OPERATORS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_CompareOperators);
+
+// Argument: DecompositionKernel::ENGINE (0 - legacy, 1 - fast)
+BENCHMARK_CAPTURE(benchDecomposition, zxDecomposition, Operator::zxDecomposition)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(benchDecomposition, zyDecomposition, Operator::zyDecomposition)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(benchDecomposition, xyDecomposition, Operator::xyDecomposition)->Arg(0)->Arg(1);
+BENCHMARK_CAPTURE(benchDecomposition, zyxDecomposition, Operator::zyxDecomposition)
+    ->Arg(0)
+    ->Arg(1);
+
+BENCHMARK_CAPTURE(benchMatrixByDec, getMatrixByZxDec, Operator::zxDecomposition,
+                  Operator::getMatrixByZxDec);
+BENCHMARK_CAPTURE(benchMatrixByDec, getMatrixByZyDec, Operator::zyDecomposition,
+                  Operator::getMatrixByZyDec);
+BENCHMARK_CAPTURE(benchMatrixByDec, getMatrixByXyDec, Operator::xyDecomposition,
+                  Operator::getMatrixByXyDec);
+BENCHMARK_CAPTURE(benchMatrixByDec, getMatrixByZyxDec, Operator::zyxDecomposition,
+                  Operator::getMatrixByZyxDec);
+
+static void BM_VectorAngleDec(benchmark::State &state) {
+    const QVector<UnitaryMatrix2x2> &ops = operators();
+    int                              k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Operator::vectorAngleDec(ops[k]));
+        k = (k + 1) % COUNT_OF_OPERATORS;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VectorAngleDec);
+
+// Batch decomposition of all the operators; arguments: engine, DecompositionKernel::KIND
+static void BM_BatchDecomposition(benchmark::State &state) {
+    const QVector<UnitaryMatrix2x2> &ops = operators();
+    QVector<double>                  re[4], im[4], dec[4];
+    for (int j = 0; j < 4; ++j) {
+        re[j].resize(COUNT_OF_OPERATORS);
+        im[j].resize(COUNT_OF_OPERATORS);
+        dec[j].resize(COUNT_OF_OPERATORS);
+    }
+    for (int k = 0; k < COUNT_OF_OPERATORS; ++k) {
+        complex m[4] = {ops[k].a(), ops[k].b(), ops[k].c(), ops[k].d()};
+        for (int j = 0; j < 4; ++j) {
+            re[j][k] = m[j].real();
+            im[j][k] = m[j].imag();
+        }
+    }
+    matrix2x2batch     batch = {re[0].constData(), im[0].constData(), re[1].constData(),
+                                im[1].constData(), re[2].constData(), im[2].constData(),
+                                re[3].constData(), im[3].constData()};
+    decompositionbatch decs = {dec[0].data(), dec[1].data(), dec[2].data(), dec[3].data()};
+
+    DecompositionKernel::setEngine(static_cast<DecompositionKernel::ENGINE>(state.range(0)));
+    DecompositionKernel::KIND kind = static_cast<DecompositionKernel::KIND>(state.range(1));
+    for (auto _ : state) {
+        DecompositionKernel::decompose(kind, batch, decs, COUNT_OF_OPERATORS);
+        benchmark::ClobberMemory();
+    }
+    DecompositionKernel::setEngine(DecompositionKernel::LEGACY);
+    state.SetItemsProcessed(state.iterations() * COUNT_OF_OPERATORS);
+}
+BENCHMARK(BM_BatchDecomposition)->ArgsProduct({{0, 1}, {0, 1, 2, 3}});
+
+// Argument: Utility::getSpeed(), which sets the number of frames of the path
+static void BM_Rotate(benchmark::State &state) {
+    int speed = static_cast<int>(Utility::getSpeed());
+    Utility::setSpeed(static_cast<int>(state.range(0)));
+    Spike    s = Vector::createSpike(1.0, 0.0, 0.0);
+    Vector3D axis = Vector3D(1, 1, 1).normalized();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Operator::rotate(s, axis, M_PI / 3));
+    }
+    Utility::setSpeed(speed);
+}
+BENCHMARK(BM_Rotate)->Arg(1)->Arg(5)->Arg(10);
+
+// Evaluation of every frame of a three-segment decomposition path; argument: speed
+static void BM_PathFrames(benchmark::State &state) {
+    int speed = static_cast<int>(Utility::getSpeed());
+    Utility::setSpeed(static_cast<int>(state.range(0)));
+    Spike s = Vector::createSpike(1.0, 0.0, 0.0);
+    Path  path = Operator::applyZyDecomposition(s, operators()[0]);
+    for (auto _ : state) {
+        for (int k = 0; k < path.size(); ++k) {
+            benchmark::DoNotOptimize(path.frame(k));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * path.size());
+    Utility::setSpeed(speed);
+}
+BENCHMARK(BM_PathFrames)->Arg(1)->Arg(5)->Arg(10);
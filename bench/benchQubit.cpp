@@ -0,0 +1,49 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/Qubit.h"
+#include <benchmark/benchmark.h>
+
+static void BM_QubitFromAB(benchmark::State &state) {
+    complex a(0.6, 0);
+    complex b(0, 0.8);
+    for (auto _ : state) {
+        Qubit q(a, b);
+        benchmark::DoNotOptimize(q);
+    }
+}
+BENCHMARK(BM_QubitFromAB);
+
+static void BM_QubitFromThePhi(benchmark::State &state) {
+    double the = M_PI / 3;
+    double phi = M_PI / 5;
+    for (auto _ : state) {
+        Qubit q(the, phi);
+        benchmark::DoNotOptimize(q);
+    }
+}
+BENCHMARK(BM_QubitFromThePhi);
+
+static void BM_QubitFromXYZ(benchmark::State &state) {
+    double x = 0.48;
+    double y = 0.6;
+    double z = 0.64;
+    for (auto _ : state) {
+        Qubit q(x, y, z);
+        benchmark::DoNotOptimize(q);
+    }
+}
+BENCHMARK(BM_QubitFromXYZ);
@@ -0,0 +1,41 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/StateVector.h"
+#include <benchmark/benchmark.h>
+
+// One Hadamard on every qubit of an n-qubit state, n = state.range(0)
+static void BM_StateVectorLayer(benchmark::State &state) {
+    int              n = static_cast<int>(state.range(0));
+    StateVector      psi(n);
+    UnitaryMatrix2x2 h = UnitaryMatrix2x2::getH();
+    for (auto _ : state) {
+        for (int k = 0; k < n; ++k) {
+            psi.apply(k, h);
+        }
+        benchmark::DoNotOptimize(psi.amplitudes());
+    }
+    state.SetBytesProcessed(state.iterations() * n * psi.size() * 2 * sizeof(complex));
+}
+BENCHMARK(BM_StateVectorLayer)->Arg(10)->Arg(16)->Arg(20)->Arg(24)->Unit(benchmark::kMillisecond);
+
+static void BM_StateVectorBlochVector(benchmark::State &state) {
+    StateVector psi(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(psi.blochVector(0));
+    }
+}
+BENCHMARK(BM_StateVectorBlochVector)->Arg(16)->Arg(20)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,30 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/utility.h"
+#include <QStringList>
+#include <benchmark/benchmark.h>
+
+static void BM_ParseStrToComplex(benchmark::State &state) {
+    const QStringList strs = {"1", "-0.5i", "0.70710678+0.70710678i", "-1.25-2i", "i"};
+    int               k = 0;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(Utility::parseStrToComplex(strs[k]));
+        k = (k + 1) % strs.size();
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ParseStrToComplex);
@@ -0,0 +1,59 @@
+# A Bloch sphere emulator program.
+# Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+# Headless quantum core (QtCore only), shared by blochsphere.pro and blochcore.pro
+
+INCLUDEPATH += $$PWD
+
+CONFIG += thread
+
+SOURCES += \
+    $$PWD/src/utility.cpp \
+    $$PWD/src/quantum/CircuitModel.cpp \
+    $$PWD/src/quantum/CircuitPlanner.cpp \
+    $$PWD/src/quantum/CircuitState.cpp \
+    $$PWD/src/quantum/DecompositionKernel.cpp \
+    $$PWD/src/quantum/Gates.cpp \
+    $$PWD/src/quantum/Operator.cpp \
+    $$PWD/src/quantum/Path.cpp \
+    $$PWD/src/quantum/Point.cpp \
+    $$PWD/src/quantum/Quaternion.cpp \
+    $$PWD/src/quantum/Qubit.cpp \
+    $$PWD/src/quantum/Session.cpp \
+    $$PWD/src/quantum/StateVector.cpp \
+    $$PWD/src/quantum/Trace.cpp \
+    $$PWD/src/quantum/UnitaryMatrix2x2.cpp \
+    $$PWD/src/quantum/Vector.cpp \
+    $$PWD/src/quantum/Vector3D.cpp
+
+HEADERS += \
+    $$PWD/src/utility.h \
+    $$PWD/src/quantum/CircuitModel.h \
+    $$PWD/src/quantum/CircuitPlanner.h \
+    $$PWD/src/quantum/CircuitState.h \
+    $$PWD/src/quantum/DecompositionKernel.h \
+    $$PWD/src/quantum/Gates.h \
+    $$PWD/src/quantum/Operator.h \
+    $$PWD/src/quantum/Path.h \
+    $$PWD/src/quantum/Point.h \
+    $$PWD/src/quantum/Quaternion.h \
+    $$PWD/src/quantum/Qubit.h \
+    $$PWD/src/quantum/Session.h \
+    $$PWD/src/quantum/StateVector.h \
+    $$PWD/src/quantum/Trace.h \
+    $$PWD/src/quantum/UnitaryMatrix2x2.h \
+    $$PWD/src/quantum/Vector.h \
+    $$PWD/src/quantum/Vector3D.h
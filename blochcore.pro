@@ -0,0 +1,27 @@
+# A Bloch sphere emulator program.
+# Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+TEMPLATE = lib
+
+QT = core
+
+QMAKE_CXXFLAGS += -std=c++11
+
+include(blochcore.pri)
+
+TARGET = blochcore
+
+CONFIG += staticlib qt warn_on
@@ -0,0 +1,45 @@
+# A Bloch sphere emulator program.
+# Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+TEMPLATE = app
+
+QT += opengl gui widgets core
+
+QMAKE_CXXFLAGS += -std=c++11
+
+include(blochcore.pri)
+
+SOURCES += \
+    src/cli/BatchJob.cpp \
+    src/render/main.cpp \
+    src/widgets/FrameSink.cpp \
+    src/widgets/Mesh.cpp \
+    src/widgets/OffscreenRenderer.cpp \
+    src/widgets/SphereScene.cpp \
+    src/widgets/TraceBuffer.cpp
+
+HEADERS += \
+    src/cli/BatchJob.h \
+    src/widgets/FrameSink.h \
+    src/widgets/Mesh.h \
+    src/widgets/OffscreenRenderer.h \
+    src/widgets/SphereScene.h \
+    src/widgets/TraceBuffer.h
+
+TARGET = blochsphere-render
+
+CONFIG += console qt warn_on
+CONFIG -= app_bundle
@@ -23,39 +23,43 @@ QMAKE_CXXFLAGS += -std=c++11
 
 win32:RC_FILE += blochsphere.rc
 
+include(blochcore.pri)
+
 SOURCES += \
     src/main.cpp \
-    src/utility.cpp \
-    src/quantum/Operator.cpp \
-    src/quantum/Point.cpp \
-    src/quantum/Qubit.cpp \
-    src/quantum/UnitaryMatrix2x2.cpp \
-    src/quantum/Vector.cpp \
     src/widgets/BlochDialog.cpp \
     src/widgets/Circuit.cpp \
-    src/widgets/CircuitOperator.cpp \
-    src/widgets/CircuitQubit.cpp \
+    src/widgets/CircuitDelegate.cpp \
+    src/widgets/CircuitTableModel.cpp \
+    src/widgets/FrameExport.cpp \
+    src/widgets/FrameSink.cpp \
+    src/widgets/Instrumentation.cpp \
     src/widgets/MainWindow.cpp \
+    src/widgets/Mesh.cpp \
     src/widgets/OpItem.cpp \
     src/widgets/Sphere.cpp \
-    src/widgets/VectorWidget.cpp
+    src/widgets/SphereScene.cpp \
+    src/widgets/TraceBuffer.cpp \
+    src/widgets/VectorWidget.cpp \
+    src/widgets/WidgetUtility.cpp
 
 
 HEADERS += \
-    src/utility.h \
-    src/quantum/Operator.h \
-    src/quantum/Point.h \
-    src/quantum/Qubit.h \
-    src/quantum/UnitaryMatrix2x2.h \
-    src/quantum/Vector.h \
     src/widgets/Circuit.h \
-    src/widgets/CircuitOperator.h \
-    src/widgets/CircuitQubit.h \
+    src/widgets/CircuitDelegate.h \
+    src/widgets/CircuitTableModel.h \
+    src/widgets/FrameExport.h \
+    src/widgets/FrameSink.h \
     src/widgets/VectorWidget.h \
     src/widgets/BlochDialog.h \
+    src/widgets/Instrumentation.h \
     src/widgets/MainWindow.h \
+    src/widgets/Mesh.h \
     src/widgets/OpItem.h \
-    src/widgets/Sphere.h
+    src/widgets/Sphere.h \
+    src/widgets/SphereScene.h \
+    src/widgets/TraceBuffer.h \
+    src/widgets/WidgetUtility.h
 
 LIBS += libopengl32
 
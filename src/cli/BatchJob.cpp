@@ -0,0 +1,399 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "BatchJob.h"
+#include "src/quantum/CircuitPlanner.h"
+#include <QJsonArray>
+#include <QStringList>
+
+namespace {
+const char *TRAJECTORY_NAMES[] = {"none", "zx", "zy", "xy", "zyx", "operator", "vector"};
+
+// Gate of the circuit menu as in the window, Rx(90), with the angle in degrees
+bool parseCell(const QString &word, circuitcell *cell) {
+    QString name = word.section('(', 0, 0);
+    int     gate = CircuitModel::findGate(name);
+    if (gate == CircuitModel::COUNT) {
+        return false;
+    }
+    cell->gate = static_cast<quint8>(gate);
+    cell->angle = 0;
+    if (not CircuitModel::hasAngle(gate)) {
+        return word.size() == name.size();
+    }
+    if (not word.endsWith(')') or word.size() < name.size() + 3) {
+        return false;
+    }
+    bool ok = false;
+    cell->angle = qDegreesToRadians(word.mid(name.size() + 1, word.size() - name.size() - 2)
+                                        .toDouble(&ok));
+    return ok;
+}
+
+// Any operator as U(a,b,c,d), with the entries written as in the operator fields of the window
+bool parseU(const QString &word, Operator *op) {
+    if (not word.startsWith("U(", Qt::CaseInsensitive) or not word.endsWith(')')) {
+        return false;
+    }
+    QStringList entries = word.mid(2, word.size() - 3).split(',');
+    if (entries.size() != 4) {
+        return false;
+    }
+    matrix2x2 m = {Utility::parseStrToComplex(entries[0]), Utility::parseStrToComplex(entries[1]),
+                   Utility::parseStrToComplex(entries[2]), Utility::parseStrToComplex(entries[3])};
+    UnitaryMatrix2x2 u;
+    if (not u.updateMatrix(m)) {
+        return false;
+    }
+    op->setOperator(u);
+    return true;
+}
+
+CircuitPlanner::Decomposition pathFunction(BatchJob::TRAJECTORY trajectory) {
+    switch (trajectory) {
+    case BatchJob::ZX:
+        return &Operator::applyZxDecomposition;
+    case BatchJob::XY:
+        return &Operator::applyXyDecomposition;
+    case BatchJob::ZYX:
+        return &Operator::applyZyxDecomposition;
+    case BatchJob::OPERATOR:
+        return &Operator::applyOperator;
+    case BatchJob::VECTOR:
+        return &Operator::applyVectorRotation;
+    default:
+        return &Operator::applyZyDecomposition;
+    }
+}
+
+QJsonArray toJson(complex c) { return QJsonArray() << c.real() << c.imag(); }
+
+QJsonArray toJson(const Vector3D &v) { return QJsonArray() << v.x() << v.y() << v.z(); }
+
+// Angles in degrees, as the window shows them
+QJsonObject toJson(const decomposition &dec) {
+    QJsonObject json;
+    json["alpha"] = qRadiansToDegrees(dec.alpha);
+    json["beta"] = qRadiansToDegrees(dec.beta);
+    json["delta"] = qRadiansToDegrees(dec.delta);
+    json["gamma"] = qRadiansToDegrees(dec.gamma);
+    return json;
+}
+
+QJsonObject describe(Operator op) {
+    QJsonObject json;
+    json["name"] = op.getOperatorName();
+    json["matrix"] = QJsonArray() << toJson(op.a()) << toJson(op.b()) << toJson(op.c())
+                                  << toJson(op.d());
+    json["zx"] = toJson(op.zxDecomposition());
+    json["zy"] = toJson(op.zyDecomposition());
+    json["xy"] = toJson(op.xyDecomposition());
+    json["zyx"] = toJson(op.zyxDecomposition());
+
+    vectorangle va = op.vectorAngleDec();
+    QJsonObject vector;
+    vector["axis"] = toJson(Vector3D(va.x, va.y, va.z));
+    vector["angle"] = qRadiansToDegrees(va.angle);
+    json["vector"] = vector;
+    return json;
+}
+
+// Bloch vector of a qubit of the final state, with its amplitudes when it is not entangled
+QJsonObject describe(const Vector3D &v) {
+    QJsonObject json;
+    json["vector"] = toJson(v);
+    if (v.length() > 1 - EPSILON) {
+        Qubit q(v.x(), v.y(), v.z());
+        json["a"] = toJson(q.a());
+        json["b"] = toJson(q.b());
+    }
+    return json;
+}
+} // namespace
+
+BatchJob::BatchJob(const QString &source, const QString &name)
+    : source_(source), name_(name), circuit_(0, 0) {}
+
+bool BatchJob::isEmpty() const {
+    return vectors_.isEmpty() and queue_.isEmpty() and circuit_.countOfSteps() == 0;
+}
+
+bool BatchJob::parseLine(const QString &line, QString *error) {
+    QString text = line.section('#', 0, 0).simplified();
+    if (text.isEmpty()) {
+        return true;
+    }
+    QStringList words = text.split(' ');
+    QString     keyword = words.takeFirst();
+
+    if (keyword == "vector") {
+        bool     okX = false, okY = false, okZ = false;
+        Vector3D v;
+        if (words.size() == 3) {
+            v = Vector3D(words[0].toDouble(&okX), words[1].toDouble(&okY), words[2].toDouble(&okZ));
+        }
+        if (not(okX and okY and okZ) or v.length() < EPSILON) {
+            *error = "vector needs three coordinates of a nonzero vector";
+            return false;
+        }
+        vectors_.append(v.normalized());
+    } else if (keyword == "op") {
+        Operator    op;
+        circuitcell c;
+        if (circuit_.countOfSteps() > 0) {
+            *error = "a job has either ops or steps";
+            return false;
+        }
+        if (words.size() == 1 and parseCell(words[0], &c)) {
+            op = CircuitModel::cellOperator(c);
+        } else if (words.size() != 1 or not parseU(words[0], &op)) {
+            *error = "op needs a gate of the circuit menu or a unitary U(a,b,c,d)";
+            return false;
+        }
+        queue_.append(op);
+    } else if (keyword == "step") {
+        if (not queue_.isEmpty()) {
+            *error = "a job has either ops or steps";
+            return false;
+        }
+        int qubits = circuit_.countOfSteps() == 0 ? words.size() : circuit_.countOfQubits();
+        if (words.size() != qubits or qubits == 0 or qubits > StateVector::MAX_QUBITS) {
+            *error = QString("step needs a gate for each of 1 to %1 qubits, the same in every step")
+                         .arg(StateVector::MAX_QUBITS);
+            return false;
+        }
+        QVector<circuitcell> cells(qubits);
+        for (int q = 0; q < qubits; ++q) {
+            if (not parseCell(words[q], &cells[q])) {
+                *error = "unknown gate " + words[q];
+                return false;
+            }
+        }
+        int step = circuit_.countOfSteps();
+        circuit_.resize(qubits, step + 1);
+        for (int q = 0; q < qubits; ++q) {
+            circuit_.setCell(q, step, cells[q]);
+        }
+    } else {
+        *error = "unknown keyword " + keyword;
+        return false;
+    }
+    return true;
+}
+
+bool BatchJob::check(QString *error) const {
+    if (circuit_.countOfSteps() > 0 and vectors_.size() > circuit_.countOfQubits()) {
+        *error = "more vectors than qubits";
+        return false;
+    }
+    if (circuit_.countOfSteps() == 0 and vectors_.size() > 1) {
+        *error = "a queue acts on one vector";
+        return false;
+    }
+    if (circuit_.hasControls() and circuit_.countOfQubits() > CircuitState::MAX_JOINT_QUBITS) {
+        *error = QString("a circuit with Ctrl gates has at most %1 qubits")
+                     .arg(CircuitState::MAX_JOINT_QUBITS);
+        return false;
+    }
+    return true;
+}
+
+bool BatchJob::checkAmplitudes(QString *error) const {
+    if (countOfQubits() > CircuitState::MAX_JOINT_QUBITS) {
+        *error = QString("amplitudes are listed for at most %1 qubits")
+                     .arg(CircuitState::MAX_JOINT_QUBITS);
+        return false;
+    }
+    return true;
+}
+
+QJsonObject BatchJob::run(TRAJECTORY trajectory, bool amplitudes) const {
+    int qubits = countOfQubits();
+    // The amplitudes of a product state are only worked out when they are asked for
+    CircuitState           state(startingVectors(), amplitudes or circuit_.hasControls());
+    QVector<QVector<Path>> moves;
+    play(&state, trajectory, trajectory != NONE ? &moves : nullptr);
+
+    QJsonObject json;
+    json["source"] = source_;
+    json["name"] = name_;
+
+    if (circuit_.countOfSteps() > 0) {
+        QJsonArray steps;
+        for (int s = 0; s < circuit_.countOfSteps(); ++s) {
+            QJsonArray ops;
+            for (int q = 0; q < qubits; ++q) {
+                ops.append(describe(circuit_.getOperator(q, s)));
+            }
+            steps.append(ops);
+        }
+        json["steps"] = steps;
+    } else {
+        QJsonArray ops;
+        for (Operator op : queue_) {
+            ops.append(describe(op));
+        }
+        json["operators"] = ops;
+        if (not queue_.isEmpty()) {
+            json["fused"] = describe(Operator::fuse(queue_));
+        }
+    }
+
+    QJsonArray finals;
+    for (int q = 0; q < qubits; ++q) {
+        finals.append(describe(state.blochVector(q)));
+    }
+    json["qubits"] = finals;
+
+    if (trajectory != NONE) {
+        QVector<Vector3D>   starts = startingVectors();
+        QVector<QJsonArray> frames(qubits);
+        for (int q = 0; q < qubits; ++q) {
+            frames[q].append(toJson(starts[q]));
+        }
+        for (const QVector<Path> &step : moves) {
+            for (int q = 0; q < qubits; ++q) {
+                for (int k = 1; k < step[q].size(); ++k) {
+                    frames[q].append(toJson(step[q].frame(k).point));
+                }
+            }
+        }
+        QJsonArray trajectories;
+        for (const QJsonArray &f : frames) {
+            trajectories.append(f);
+        }
+        json["trajectories"] = trajectories;
+    }
+    if (amplitudes) {
+        const StateVector *joint = state.jointState();
+        QJsonArray         values;
+        for (qint64 k = 0; k < joint->size(); ++k) {
+            values.append(toJson(joint->amplitude(k)));
+        }
+        json["amplitudes"] = values;
+    }
+    return json;
+}
+
+int BatchJob::countOfQubits() const {
+    return circuit_.countOfSteps() > 0 ? circuit_.countOfQubits() : 1;
+}
+
+QVector<Vector3D> BatchJob::startingVectors() const {
+    QVector<Vector3D> starts(countOfQubits(), Vector3D(0, 0, 1));
+    for (int q = 0; q < vectors_.size(); ++q) {
+        starts[q] = vectors_[q];
+    }
+    return starts;
+}
+
+QVector<QVector<Path>> BatchJob::paths(TRAJECTORY trajectory) const {
+    CircuitState           state(startingVectors(), circuit_.hasControls());
+    QVector<QVector<Path>> moves;
+    play(&state, trajectory, &moves);
+    return moves;
+}
+
+void BatchJob::play(CircuitState *state, TRAJECTORY trajectory,
+                    QVector<QVector<Path>> *moves) const {
+    int                           qubits = countOfQubits();
+    CircuitPlanner::Decomposition fun = pathFunction(trajectory);
+    QVector<Spike>                spikes(qubits);
+    QVector<Vector3D>             starts = startingVectors();
+    for (int q = 0; q < qubits; ++q) {
+        spikes[q].point = starts[q];
+    }
+
+    bool isCircuit = circuit_.countOfSteps() > 0;
+    int  count = isCircuit ? circuit_.countOfSteps() : queue_.size();
+    for (int s = 0; s < count; ++s) {
+        if (isCircuit) {
+            state->applyStep(circuit_, s);
+        } else {
+            Operator op = queue_[s];
+            state->apply(0, op.getOperator());
+        }
+        if (moves == nullptr) {
+            continue;
+        }
+        bool          isControlled = isCircuit and not circuit_.getControls(s).isEmpty();
+        QVector<Path> step;
+        for (int q = 0; q < qubits; ++q) {
+            Operator op = isCircuit ? circuit_.getOperator(q, s) : queue_[s];
+            Vector3D end = state->blochVector(q);
+            step.append(isControlled ? CircuitPlanner::turn(end, spikes[q])
+                                     : CircuitPlanner::move(op, fun, end, spikes[q]));
+            spikes[q] = step.last().last();
+        }
+        moves->append(step);
+    }
+}
+
+BatchJob::TRAJECTORY BatchJob::trajectoryByName(const QString &name, bool *ok) {
+    for (int t = NONE; t <= VECTOR; ++t) {
+        if (name.compare(TRAJECTORY_NAMES[t], Qt::CaseInsensitive) == 0) {
+            *ok = true;
+            return static_cast<TRAJECTORY>(t);
+        }
+    }
+    *ok = false;
+    return NONE;
+}
+
+BatchReader::BatchReader(QIODevice *device, const QString &source)
+    : stream_(device), source_(source) {}
+
+bool BatchReader::next(BatchJob *job, QString *error) {
+    bool     hasHeader = hasHeader_;
+    BatchJob current(source_ + ":" + QString::number(headerLine_), headerName_);
+    bool     isValid = true;
+    hasHeader_ = false;
+    headerName_.clear();
+    error->clear();
+
+    while (not stream_.atEnd()) {
+        QString line = stream_.readLine();
+        QString text = line.section('#', 0, 0).simplified();
+        ++lineNumber_;
+        if (text == "job" or text.startsWith("job ")) {
+            if (hasHeader or not current.isEmpty() or not isValid) {
+                hasHeader_ = true;
+                headerLine_ = lineNumber_;
+                headerName_ = text.mid(4);
+                break;
+            }
+            // Only blank lines and comments so far: this line starts the job
+            current = BatchJob(source_ + ":" + QString::number(lineNumber_), text.mid(4));
+            hasHeader = true;
+            continue;
+        }
+        if (isValid and not current.parseLine(line, error)) {
+            *error = QString("%1:%2: %3").arg(source_).arg(lineNumber_).arg(*error);
+            isValid = false;
+        }
+    }
+
+    if (isValid and not current.check(error)) {
+        *error = current.getSource() + ": " + *error;
+        isValid = false;
+    }
+    if (not isValid or not current.isEmpty() or not current.getName().isEmpty()) {
+        *job = current;
+        return true;
+    }
+    // Nothing to run, such as a bare job line
+    return hasHeader_ and next(job, error);
+}
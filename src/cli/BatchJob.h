@@ -0,0 +1,100 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef BATCHJOB_HPP
+#define BATCHJOB_HPP
+
+#include "src/quantum/CircuitModel.h"
+#include "src/quantum/CircuitState.h"
+#include "src/quantum/Operator.h"
+#include <QIODevice>
+#include <QJsonObject>
+#include <QTextStream>
+#include <QVector>
+
+// Operator queue or circuit of blochsphere-cli, read from a job file line by line:
+//
+//     job bell            starts the next job of the file and names it
+//     vector 0 0 1        starting Bloch vector (x y z), one per qubit of a circuit, |0> if none
+//     op Rx(90)           operator appended to the queue
+//     step H Id           circuit step, a gate per qubit
+//     step Ctrl X         the other gates of the step act where the Ctrl qubits are 1, a CNOT
+//
+// Gates are written as in the circuit menu with angles in degrees; queues also take any operator
+// as U(a,b,c,d). A job has either a queue or steps, and # starts a comment.
+class BatchJob {
+public:
+    // Path of the trajectories, as the decomposition buttons of the window choose it
+    enum TRAJECTORY { NONE = 0, ZX, ZY, XY, ZYX, OPERATOR, VECTOR };
+
+    explicit BatchJob(const QString &source = QString(), const QString &name = QString());
+
+    QString getSource() const { return source_; }
+    QString getName() const { return name_; }
+    bool    isEmpty() const;
+
+    // False with the reason in error when the line is malformed
+    bool parseLine(const QString &line, QString *error);
+    // False with the reason in error when the lines read do not make up a job
+    bool check(QString *error) const;
+    // False with the reason in error when the job has too many qubits to list its amplitudes
+    bool checkAmplitudes(QString *error) const;
+
+    // Final qubits and the decompositions of every operator, as one JSON object. With a
+    // trajectory it also has every frame the vectors pass through, and with amplitudes the
+    // amplitudes of the final state.
+    QJsonObject run(TRAJECTORY trajectory, bool amplitudes) const;
+
+    int               countOfQubits() const;
+    QVector<Vector3D> startingVectors() const;
+    // Paths of the qubits for each operator or step, one after another as the window plays them.
+    // NONE takes the zy decomposition, the default of the window.
+    QVector<QVector<Path>> paths(TRAJECTORY trajectory) const;
+
+    static TRAJECTORY trajectoryByName(const QString &name, bool *ok);
+
+private:
+    QString           source_;
+    QString           name_;
+    QVector<Vector3D> vectors_;
+    QVector<Operator> queue_;
+    CircuitModel      circuit_;
+
+    // Applies the operators or steps to state, with the paths of the qubits in moves unless it is
+    // null
+    void play(CircuitState *state, TRAJECTORY trajectory, QVector<QVector<Path>> *moves) const;
+};
+
+// Jobs of a job file, read one at a time so that files of any length take bounded memory
+class BatchReader {
+public:
+    BatchReader(QIODevice *device, const QString &source);
+
+    // Reads the next job, false at the end of the file. Malformed jobs are returned too, with the
+    // reason in error, so that callers can report them and go on.
+    bool next(BatchJob *job, QString *error);
+
+private:
+    QTextStream stream_;
+    QString     source_;
+    int         lineNumber_ = 0;
+    // Job line read at the end of the previous job
+    bool    hasHeader_ = false;
+    int     headerLine_ = 1;
+    QString headerName_;
+};
+
+#endif // BATCHJOB_HPP
@@ -0,0 +1,190 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "BatchJob.h"
+#include <QCommandLineParser>
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QTextStream>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+// Jobs read before they are run, so memory stays bounded whatever the length of the input
+const int JOBS_PER_BATCH = 1024;
+
+struct runoptions {
+    BatchJob::TRAJECTORY trajectory;
+    bool                 amplitudes;
+    int                  threads;
+};
+
+// Runs the jobs on the worker threads and writes one JSON line per job, in the order of the input
+void runBatch(const QVector<BatchJob> &jobs, const runoptions &options, QFile *out) {
+    std::vector<QByteArray> results(jobs.size());
+    std::atomic<int>        next(0);
+
+    auto work = [&]() {
+        for (int k = next++; k < jobs.size(); k = next++) {
+            QJsonObject json = jobs[k].run(options.trajectory, options.amplitudes);
+            results[k] = QJsonDocument(json).toJson(QJsonDocument::Compact);
+        }
+    };
+    std::vector<std::thread> workers;
+    for (int t = 1; t < qMin(options.threads, jobs.size()); ++t) {
+        workers.emplace_back(work);
+    }
+    work();
+    for (std::thread &worker : workers) {
+        worker.join();
+    }
+
+    for (const QByteArray &result : results) {
+        out->write(result);
+        out->write("\n");
+    }
+}
+
+// Reads the jobs of a file, running them batch by batch. False if a job was malformed; the
+// other jobs still run.
+bool runFile(QFile *in, const QString &source, const runoptions &options, QFile *out) {
+    BatchReader       reader(in, source);
+    QVector<BatchJob> jobs;
+    BatchJob          job;
+    QString           error;
+    bool              isSuccess = true;
+
+    while (reader.next(&job, &error)) {
+        if (error.isEmpty() and options.amplitudes and not job.checkAmplitudes(&error)) {
+            error = job.getSource() + ": " + error;
+        }
+        if (not error.isEmpty()) {
+            QTextStream(stderr) << error << "\n";
+            isSuccess = false;
+            continue;
+        }
+        jobs.append(job);
+        if (jobs.size() == JOBS_PER_BATCH) {
+            runBatch(jobs, options, out);
+            jobs.clear();
+        }
+    }
+    runBatch(jobs, options, out);
+    return isSuccess;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("blochsphere-cli");
+    QCoreApplication::setApplicationVersion(BLOCHSPHERE_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Runs the operator queues and circuits of job files without a window and writes one JSON "
+        "line per job with the final qubits and the decompositions of the operators.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption outputOption(QStringList() << "o"
+                                                  << "output",
+                                    "Write the results to <file> instead of stdout.", "file");
+    QCommandLineOption trajectoryOption(
+        QStringList() << "t"
+                      << "trajectory",
+        "Add every frame the vectors pass through along <path>: zx, zy, xy, zyx, operator or "
+        "vector.",
+        "path");
+    QCommandLineOption amplitudesOption("amplitudes", "Add the amplitudes of the final state.");
+    QCommandLineOption jobsOption(QStringList() << "j"
+                                                << "jobs",
+                                  "Run <n> jobs at once, as many as the processor has threads "
+                                  "by default.",
+                                  "n");
+    QCommandLineOption engineOption("engine",
+                                    "Decompose the operators with the legacy or the fast "
+                                    "engine; legacy by default.",
+                                    "name");
+    parser.addOption(outputOption);
+    parser.addOption(trajectoryOption);
+    parser.addOption(amplitudesOption);
+    parser.addOption(jobsOption);
+    parser.addOption(engineOption);
+    parser.addPositionalArgument("files", "Job files, standard input if none or -.", "[files...]");
+    parser.process(app);
+
+    runoptions options;
+    options.trajectory = BatchJob::NONE;
+    options.amplitudes = parser.isSet(amplitudesOption);
+    options.threads = qMax(1, static_cast<int>(std::thread::hardware_concurrency()));
+    if (parser.isSet(trajectoryOption)) {
+        bool ok = false;
+        options.trajectory = BatchJob::trajectoryByName(parser.value(trajectoryOption), &ok);
+        if (not ok) {
+            QTextStream(stderr) << "unknown trajectory " << parser.value(trajectoryOption) << "\n";
+            return 2;
+        }
+    }
+    if (parser.isSet(engineOption)) {
+        bool                        ok = false;
+        DecompositionKernel::ENGINE engine =
+            DecompositionKernel::engineByName(parser.value(engineOption), &ok);
+        if (not ok) {
+            QTextStream(stderr) << "unknown engine " << parser.value(engineOption) << "\n";
+            return 2;
+        }
+        DecompositionKernel::setEngine(engine);
+    }
+    if (parser.isSet(jobsOption)) {
+        bool ok = false;
+        options.threads = parser.value(jobsOption).toInt(&ok);
+        if (not ok or options.threads < 1) {
+            QTextStream(stderr) << "jobs needs a positive number\n";
+            return 2;
+        }
+    }
+
+    QFile out;
+    if (parser.isSet(outputOption)) {
+        out.setFileName(parser.value(outputOption));
+        if (not out.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QTextStream(stderr) << out.fileName() << ": " << out.errorString() << "\n";
+            return 2;
+        }
+    } else if (not out.open(stdout, QIODevice::WriteOnly)) {
+        return 2;
+    }
+
+    QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        files << "-";
+    }
+    bool isSuccess = true;
+    for (const QString &name : files) {
+        QFile in(name);
+        bool  isOpen = name == "-" ? in.open(stdin, QIODevice::ReadOnly)
+                                   : in.open(QIODevice::ReadOnly);
+        if (not isOpen) {
+            QTextStream(stderr) << name << ": " << in.errorString() << "\n";
+            isSuccess = false;
+            continue;
+        }
+        QString source = name == "-" ? QString("stdin") : name;
+        isSuccess = runFile(&in, source, options, &out) and isSuccess;
+    }
+    return isSuccess ? 0 : 1;
+}
@@ -26,6 +26,20 @@ int main(int argc, char *argv[]) {
     QTextCodec::setCodecForCStrings(QTextCodec::codecForName("utf-8"));
 #endif
 
+    // Kiosk setups running for hours can bound the trace memory further
+    if (qEnvironmentVariableIsSet("BLOCHSPHERE_TRACE_LIMIT")) {
+        TracePolicy policy = Trace::getPolicy();
+        policy.maxVertices = qEnvironmentVariableIntValue("BLOCHSPHERE_TRACE_LIMIT");
+        Trace::setPolicy(policy);
+    }
+
+    if (qEnvironmentVariableIsSet("BLOCHSPHERE_MAX_SPHERES")) {
+        Utility::setMaxCountOfSpheres(qEnvironmentVariableIntValue("BLOCHSPHERE_MAX_SPHERES"));
+    }
+    if (qEnvironmentVariableIsSet("BLOCHSPHERE_MAX_STEPS")) {
+        Utility::setMaxCountOfSteps(qEnvironmentVariableIntValue("BLOCHSPHERE_MAX_STEPS"));
+    }
+
     MainWindow      w;
     QDesktopWidget *desktop = QApplication::desktop();
 
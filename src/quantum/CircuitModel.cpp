@@ -0,0 +1,142 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CircuitModel.h"
+#include <cassert>
+
+CircuitModel::CircuitModel(int countOfQubits, int countOfSteps)
+    : countOfQubits_(countOfQubits), countOfSteps_(countOfSteps),
+      cells_(countOfQubits * countOfSteps) {
+    assert(countOfQubits >= 0 and countOfSteps >= 0);
+}
+
+void CircuitModel::resize(int countOfQubits, int countOfSteps) {
+    assert(countOfQubits >= 0 and countOfSteps >= 0);
+    if (countOfQubits == countOfQubits_) {
+        cells_.resize(countOfQubits * countOfSteps);
+        countOfSteps_ = countOfSteps;
+        return;
+    }
+
+    QVector<circuitcell> cells(countOfQubits * countOfSteps);
+    int                  qubits = qMin(countOfQubits, countOfQubits_);
+    int                  steps = qMin(countOfSteps, countOfSteps_);
+    for (int s = 0; s < steps; ++s) {
+        for (int q = 0; q < qubits; ++q) {
+            cells[s * countOfQubits + q] = cells_[s * countOfQubits_ + q];
+        }
+    }
+    cells_ = cells;
+    countOfQubits_ = countOfQubits;
+    countOfSteps_ = countOfSteps;
+}
+
+circuitcell CircuitModel::cell(int qubit, int step) const {
+    assert(qubit >= 0 and qubit < countOfQubits_ and step >= 0 and step < countOfSteps_);
+    return cells_[step * countOfQubits_ + qubit];
+}
+
+void CircuitModel::setCell(int qubit, int step, circuitcell c) {
+    assert(qubit >= 0 and qubit < countOfQubits_ and step >= 0 and step < countOfSteps_);
+    assert(c.gate < COUNT);
+    cells_[step * countOfQubits_ + qubit] = c;
+}
+
+Operator CircuitModel::getOperator(int qubit, int step) const {
+    return cellOperator(cell(qubit, step));
+}
+
+Operator CircuitModel::cellOperator(circuitcell c) {
+    Operator op;
+    switch (c.gate) {
+    case X:
+        op.toX();
+        break;
+    case Y:
+        op.toY();
+        break;
+    case Z:
+        op.toZ();
+        break;
+    case H:
+        op.toH();
+        break;
+    case S:
+        op.toS();
+        break;
+    case T:
+        op.toT();
+        break;
+    case PHI:
+        op.toPhi(c.angle);
+        break;
+    case RX:
+        op.toXrotate(c.angle);
+        break;
+    case RY:
+        op.toYrotate(c.angle);
+        break;
+    case RZ:
+        op.toZrotate(c.angle);
+        break;
+    // CTRL leaves its own qubit as it is
+    default:
+        break;
+    }
+    return op;
+}
+
+QVector<UnitaryMatrix2x2> CircuitModel::getStep(int step) const {
+    QVector<UnitaryMatrix2x2> ops;
+    for (int q = 0; q < countOfQubits_; ++q) {
+        ops.append(getOperator(q, step).getOperator());
+    }
+    return ops;
+}
+
+QVector<int> CircuitModel::getControls(int step) const {
+    QVector<int> controls;
+    for (int q = 0; q < countOfQubits_; ++q) {
+        if (cell(q, step).gate == CTRL) {
+            controls.append(q);
+        }
+    }
+    return controls;
+}
+
+bool CircuitModel::hasControls() const {
+    for (const circuitcell &c : cells_) {
+        if (c.gate == CTRL) {
+            return true;
+        }
+    }
+    return false;
+}
+
+QString CircuitModel::gateName(int gate) {
+    static const char *names[COUNT] = {"Id", "X", "Y", "Z", "H", "S",
+                                       "T", "Phi", "Rx", "Ry", "Rz", "Ctrl"};
+    return gate >= 0 and gate < COUNT ? QString(names[gate]) : QString();
+}
+
+int CircuitModel::findGate(const QString &name) {
+    for (int gate = 0; gate < COUNT; ++gate) {
+        if (name.compare(gateName(gate), Qt::CaseInsensitive) == 0) {
+            return gate;
+        }
+    }
+    return COUNT;
+}
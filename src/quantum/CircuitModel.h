@@ -0,0 +1,68 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CIRCUITMODEL_HPP
+#define CIRCUITMODEL_HPP
+
+#include "Operator.h"
+#include <QVector>
+
+// Cell of a circuit: a gate of the circuit menu and, for Phi and the rotations, its angle (rad)
+struct circuitcell {
+    quint8 gate;
+    double angle;
+};
+
+// Circuit as a dense step x qubit grid of cells, stored step after step, so that adding steps
+// only appends. Widgets show it; nothing here depends on them.
+//
+// A CTRL cell is the identity on its own qubit and makes the other gates of its step act only
+// where its qubit is 1, e.g. a CNOT is CTRL and X in one step. This is how qubits get entangled.
+class CircuitModel {
+public:
+    enum GATE { ID = 0, X, Y, Z, H, S, T, PHI, RX, RY, RZ, CTRL, COUNT };
+
+    explicit CircuitModel(int countOfQubits = 0, int countOfSteps = 1);
+
+    int countOfQubits() const { return countOfQubits_; }
+    int countOfSteps() const { return countOfSteps_; }
+    // Keeps the cells that stay inside the grid; new cells are Id
+    void resize(int countOfQubits, int countOfSteps);
+
+    circuitcell cell(int qubit, int step) const;
+    void        setCell(int qubit, int step, circuitcell c);
+
+    Operator                  getOperator(int qubit, int step) const;
+    QVector<UnitaryMatrix2x2> getStep(int step) const;
+    // Qubits of the CTRL cells of the step
+    QVector<int> getControls(int step) const;
+    // Whether any step has a CTRL cell, so the qubits can become entangled
+    bool hasControls() const;
+
+    // Operator of a cell, wherever the cell is
+    static Operator cellOperator(circuitcell c);
+    // Menu text of the gate, and the gate of a menu text in any case or COUNT if there is none
+    static QString gateName(int gate);
+    static int     findGate(const QString &name);
+    static bool    hasAngle(int gate) { return gate >= PHI and gate <= RZ; }
+
+private:
+    int                  countOfQubits_;
+    int                  countOfSteps_;
+    QVector<circuitcell> cells_;
+};
+
+#endif // CIRCUITMODEL_HPP
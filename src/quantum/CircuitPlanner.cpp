@@ -0,0 +1,116 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "CircuitPlanner.h"
+
+CircuitPlanner::~CircuitPlanner() { stop(); }
+
+void CircuitPlanner::start(const CircuitModel &circuit, const QVector<Spike> &spikes,
+                           Decomposition decomposition) {
+    stop();
+    circuit_ = circuit;
+    spikes_.clear();
+    QVector<Vector3D> points;
+    for (const Spike &s : spikes) {
+        Spike pure;
+        pure.point = s.point.normalized();
+        if (pure.point.lengthSquared() == 0) {
+            pure.point = Vector3D(0, 0, 1);
+        }
+        spikes_.append(pure);
+        points.append(pure.point);
+    }
+    state_ = CircuitState(points, circuit.hasControls());
+    step_ = 0;
+    decomposition_ = decomposition;
+    planNext();
+}
+
+circuitstep CircuitPlanner::takeStep(Decomposition decomposition) {
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    if (step_ >= circuit_.countOfSteps()) {
+        return circuitstep();
+    }
+
+    circuitstep step = planned_;
+    if (decomposition != decomposition_) {
+        decomposition_ = decomposition;
+        // Turns do not depend on the decomposition
+        bool isControlled = not circuit_.getControls(step_).isEmpty();
+        for (int q = 0; q < step.paths.size() and not isControlled; ++q) {
+            step.paths[q] = move(step.operators[q], decomposition, ends_[q], spikes_[q]);
+        }
+    }
+    // The qubits start the next step where this one leaves them
+    for (int q = 0; q < step.paths.size(); ++q) {
+        spikes_[q] = step.paths[q].last();
+    }
+    ++step_;
+    planNext();
+    return step;
+}
+
+void CircuitPlanner::stop() {
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+    circuit_ = CircuitModel(0, 0);
+    state_ = CircuitState();
+    step_ = 0;
+    spikes_.clear();
+    ends_.clear();
+    planned_ = circuitstep();
+}
+
+Path CircuitPlanner::move(Operator op, Decomposition decomposition, const Vector3D &end,
+                          Spike spike) {
+    Path  path = (op.*decomposition)(spike);
+    Spike s;
+    s.point = end;
+    path.setLast(s);
+    return path;
+}
+
+Path CircuitPlanner::turn(const Vector3D &end, Spike spike) {
+    Path  path(spike);
+    Spike s;
+    s.point = end;
+    path.addTurn(s);
+    return path;
+}
+
+void CircuitPlanner::plan() {
+    state_.applyStep(circuit_, step_);
+    planned_ = circuitstep();
+    ends_.clear();
+    bool isControlled = not circuit_.getControls(step_).isEmpty();
+    for (int q = 0; q < circuit_.countOfQubits(); ++q) {
+        Operator op = circuit_.getOperator(q, step_);
+        ends_.append(state_.blochVector(q));
+        planned_.operators.append(op);
+        planned_.paths.append(isControlled ? turn(ends_.last(), spikes_[q])
+                                           : move(op, decomposition_, ends_.last(), spikes_[q]));
+    }
+}
+
+void CircuitPlanner::planNext() {
+    if (step_ < circuit_.countOfSteps()) {
+        worker_ = std::thread(&CircuitPlanner::plan, this);
+    }
+}
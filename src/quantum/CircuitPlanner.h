@@ -0,0 +1,78 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef CIRCUITPLANNER_HPP
+#define CIRCUITPLANNER_HPP
+
+#include "CircuitModel.h"
+#include "CircuitState.h"
+#include "Operator.h"
+#include "Path.h"
+#include <QVector>
+#include <thread>
+
+// Operators of one circuit step and the paths of the qubits through it
+struct circuitstep {
+    QVector<Operator> operators;
+    QVector<Path>     paths;
+};
+
+// Plays a circuit one step ahead of the window: while a step animates, a worker thread applies
+// the next one to the state and decomposes its operators, so steps start without a pause.
+class CircuitPlanner {
+public:
+    typedef Path (Operator::*Decomposition)(Spike);
+
+    CircuitPlanner() = default;
+    ~CircuitPlanner();
+    CircuitPlanner(const CircuitPlanner &) = delete;
+    CircuitPlanner &operator=(const CircuitPlanner &) = delete;
+
+    // Starts planning the first step of a copy of the circuit for pure qubits in the directions of
+    // the spikes; a qubit at the centre starts as |0>
+    void start(const CircuitModel &circuit, const QVector<Spike> &spikes,
+               Decomposition decomposition);
+    // Next step, waiting for the worker if it is still planning it, and starts planning the one
+    // after. Paths of another decomposition than the planned one are redone here. Empty after
+    // the last step.
+    circuitstep takeStep(Decomposition decomposition);
+    // Waits for the worker and drops the circuit
+    void stop();
+
+    // Path of spike through op, ending exactly at the Bloch vector end, whose length the rotations
+    // keep
+    static Path move(Operator op, Decomposition decomposition, const Vector3D &end, Spike spike);
+    // Path of spike straight to the Bloch vector end, for steps with CTRL cells: there the gate
+    // of a cell does not tell how its qubit moves, and the qubits may become mixed
+    static Path turn(const Vector3D &end, Spike spike);
+
+private:
+    CircuitModel      circuit_ = CircuitModel(0, 0);
+    CircuitState      state_;
+    int               step_ = 0;
+    Decomposition     decomposition_ = nullptr;
+    QVector<Spike>    spikes_;
+    QVector<Vector3D> ends_;
+    circuitstep       planned_;
+    std::thread       worker_;
+
+    // Runs on the worker: applies step_ to the state and decomposes it from spikes_
+    void plan();
+    void planNext();
+};
+
+#endif // CIRCUITPLANNER_HPP
@@ -0,0 +1,54 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "CircuitState.h"
+#include <cassert>
+
+CircuitState::CircuitState(const QVector<Vector3D> &vectors, bool isJoint)
+    : isJoint_(isJoint and not vectors.isEmpty()), countOfQubits_(vectors.size()) {
+    if (isJoint_) {
+        joint_ = StateVector::fromBlochVectors(vectors);
+        return;
+    }
+    for (const Vector3D &v : vectors) {
+        qubits_.append(StateVector::fromBlochVectors({v}));
+    }
+}
+
+void CircuitState::apply(int qubit, const UnitaryMatrix2x2 &op) {
+    if (isJoint_) {
+        joint_.apply(qubit, op);
+    } else {
+        qubits_[qubit].apply(0, op);
+    }
+}
+
+void CircuitState::applyStep(const CircuitModel &circuit, int step) {
+    QVector<UnitaryMatrix2x2> ops = circuit.getStep(step);
+    if (isJoint_) {
+        joint_.applyStep(ops, circuit.getControls(step));
+        return;
+    }
+    assert(circuit.getControls(step).isEmpty());
+    for (int q = 0; q < ops.size(); ++q) {
+        qubits_[q].applyStep({ops[q]});
+    }
+}
+
+Vector3D CircuitState::blochVector(int qubit) const {
+    return isJoint_ ? joint_.blochVector(qubit) : qubits_[qubit].blochVector(0);
+}
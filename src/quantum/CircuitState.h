@@ -0,0 +1,53 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef CIRCUITSTATE_HPP
+#define CIRCUITSTATE_HPP
+
+#include "CircuitModel.h"
+#include "StateVector.h"
+#include <QVector>
+
+// Qubits of a circuit as it runs. Without CTRL cells the qubits never entangle, so each one is
+// kept on its own in a state of two amplitudes; only a joint state holds all 2^n amplitudes.
+class CircuitState {
+public:
+    // Most qubits of a joint state the window and blochsphere-cli run, 256 MiB of amplitudes
+    static const int MAX_JOINT_QUBITS = 24;
+
+    explicit CircuitState(const QVector<Vector3D> &vectors = {}, bool isJoint = false);
+
+    int  countOfQubits() const { return countOfQubits_; }
+    bool isJoint() const { return isJoint_; }
+
+    void apply(int qubit, const UnitaryMatrix2x2 &op);
+    // Steps with CTRL cells need a joint state
+    void applyStep(const CircuitModel &circuit, int step);
+
+    // Bloch vector of the reduced state of the qubit; shorter than 1 when it is entangled
+    Vector3D blochVector(int qubit) const;
+    // All the amplitudes; null unless the state is joint
+    const StateVector *jointState() const { return isJoint_ ? &joint_ : nullptr; }
+
+private:
+    bool                 isJoint_;
+    int                  countOfQubits_;
+    QVector<StateVector> qubits_;
+    StateVector          joint_;
+};
+
+#endif // CIRCUITSTATE_HPP
@@ -0,0 +1,617 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "DecompositionKernel.h"
+#include <atomic>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define BLOCH_SSE2
+#endif
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define BLOCH_AVX2
+#endif
+
+namespace {
+const std::size_t BLOCK_SIZE = 256;
+const int         COUNT_OF_CASES = 16;
+
+// Read by the worker threads of circuits and of blochsphere-cli
+std::atomic<DecompositionKernel::ENGINE> engine(DecompositionKernel::LEGACY);
+const char                              *ENGINE_NAMES[] = {"legacy", "fast"};
+
+// Author  : Швецкий Михаил Владимирович
+// clang-format off
+
+double alphaAngle(complex a, complex b, complex c, complex d) {
+    double EPS = EPSILON;
+    double alpha = 0;
+
+    // ----------------------------
+    // Корректировка значения alpha
+    // ----------------------------
+    if (abs(d)>EPS)
+      if (abs(complex(1)+a/conj(d))<EPS)
+        alpha=M_PI/2.0;
+      else alpha=arg(a/conj(d))/2.0;
+    else if (abs(c)>EPS)
+      if (abs(complex(1)-b/conj(c))<EPS)
+        alpha=M_PI/2.0;
+      else alpha=arg(-b/conj(c))/2.0;
+    // ------------------------------
+    return alpha;
+}
+
+void halfAngles(complex a, complex b, complex c, complex d, double alpha,
+                double &a1, double &a2, double &b1, double &b2) {
+    complex i = complex(0, 1);
+    complex A, B;
+    A = (exp(-i*alpha)*(a+b) + exp(i*alpha)*(conj(c)+conj(d)))/2.0;
+    B = (exp(-i*alpha)*(a+b) - exp(i*alpha)*(conj(c)+conj(d)))/2.0;
+
+    a1 = real(A); a2 = imag(A); b1 = real(B); b2 = imag(B);
+}
+
+// Shared by the Z-X, Z-Y and X-Y decompositions; they differ only in the order of a1, a2, b1, b2
+decomposition rotations(double a1, double a2, double b1, double b2) {
+    double EPS = EPSILON;
+    double beta = 0;
+    double delta = 0;
+    double gamma = 0;
+
+    if (fabs(a1)<EPS && fabs(b2)<EPS)
+      if (fabs(b1)>EPS)                     // a1=0, a2=?, b1!=0, b2=0
+      {
+        delta=0;                            // delta - любое из R
+        beta=delta + 2.0*atan2(-a2,-b1);
+        gamma=M_PI;
+      }
+      else if (fabs(a2)>EPS)                // a1=0, a2!=0, b1=?, b2=0
+           {
+             delta= M_PI;                   // delta - любое из R
+             beta = delta-M_PI+2.0*atan2(-b1,a2);
+             gamma= M_PI;
+           }
+           else;
+    // ------------------------------
+    if (fabs(a2)<EPS && fabs(b1)<EPS)
+      if (fabs(a1)>EPS)                     // a1!=0, a2=0, b1=0, b2=?
+      {
+        delta=0;                            // delta - любое из R
+        beta=-delta + 2.0*atan2(-b2,a1);
+        gamma=0;
+      }
+      else if (fabs(b2)>EPS)                // a1=?, a2=0, b1=0, b2!=0
+           {
+             delta=0;                       // delta - любое из R
+             beta =-delta-M_PI+2.0*atan2(a1,b2);
+             gamma=0;
+           }
+           else;
+    // ---------------------------------------------
+    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)<EPS
+                     && fabs(b2)>EPS)       // a1=0, a2!=0, b1=0, b2!=0
+    {
+      beta=M_PI;
+      gamma=2.0*atan2(-a2,-b2);
+      delta=0;
+    }
+    // ---------------------------------------------
+    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
+                     && fabs(b2)<EPS)       // a1!=0, a2!=0, b1=0, b2=0
+    {
+      beta=M_PI/2.0;
+      gamma=2.0*atan2(-a2,a1);
+      delta=-M_PI/2.0;
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
+                     && fabs(b2)<EPS)       // a1!=0, a2=0, b1!=0, b2=0
+    {
+      beta=0;
+      gamma=2.0*atan2(-b1,a1);
+      delta=0;
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
+                     && fabs(b2)>EPS)       // a1!=0, a2=0, b1!=0, b2!=0
+    {
+      beta=atan(-b2/a1);
+      gamma=2.0*atan2(-b1,-b2/sin(beta));
+      delta=beta;
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
+                     && fabs(b2)>EPS)       // a1!=0, a2!=0, b1!=0, b2!=0
+    {
+      beta =atan(-b2/a1)+atan(a2/b1);
+      delta=atan(-b2/a1)-atan(a2/b1);
+      gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
+                      a1/cos(beta/2.0+delta/2.0));
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
+                     && fabs(b2)<EPS)       // a1!=0, a2!=0, b1!=0, b2=0
+    {
+      beta =atan(-b2/a1)+atan(a2/b1);
+      delta=atan(-b2/a1)-atan(a2/b1);
+      gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
+                      a1/cos(beta/2.0+delta/2.0));
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)<EPS && fabs(a2)<EPS && fabs(b1)>EPS
+                     && fabs(b2)>EPS)       // a1=0, a2=0, b1!=0, b2!=0
+    {
+      beta=M_PI/2.0;
+      gamma=2.0*atan2(-b1,-b2);
+      delta=M_PI/2.0;
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)>EPS
+                     && fabs(b2)>EPS)       // a1=0, a2!=0, b1!=0, b2!=0
+    {
+      beta  = M_PI/2.0 + atan(a2/b1);
+      delta = M_PI-beta;
+      gamma = 2.0*atan2(-b1/cos(beta/2.0-delta/2.0),-b2);
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
+                     && fabs(b2)>EPS)       // a1!=0, a2!=0, b1=0, b2!=0
+    {
+      beta  = M_PI/2.0 + atan(-b2/a1);
+      delta = -M_PI + beta;
+      gamma = 2.0*atan2(-a2, -b2/sin(beta/2.0+delta/2.0));
+    }
+    else;
+
+
+    decomposition dec;
+    dec.beta = beta;
+    dec.delta = delta;
+    dec.gamma = gamma;
+    return dec;
+}
+
+decomposition zyxRotations(double u1, double u2, double u3, double u4) {
+    double EPS = EPSILON;
+    double beta = 0;
+    double delta = 0;
+    double gamma = 0;
+
+    // ---------------------------------------------
+    if (fabs(u1)<EPS && fabs(u3)<EPS && fabs(u2)>EPS)
+    {
+    gamma=M_PI/2.0;
+    delta=0;       // delta - любое из R
+    if (-u4>0)
+    beta=delta + 2.0*acos(1.0/sqrt(2.0)*u2);     // (!)
+    else beta=delta - 2.0*acos(1.0/sqrt(2.0)*u2);  // (!)
+    }
+    else if (fabs(u1)<EPS && fabs(u3)<EPS && fabs(u4)>EPS)
+    {
+     gamma=M_PI/2.0;
+     delta=0;                // delta - любое из R
+     beta=delta - M_PI + 2.0*atan2(1.0/sqrt(2.0)*u2,
+                                   1.0/sqrt(2.0)*u4);
+    }
+    else;
+    // ----------------------------------------------
+    if (fabs(u4)<EPS && fabs(u2)<EPS && fabs(u1)>EPS)
+    {
+    gamma=-M_PI/2;                // или gamma=3*M_PI/2;
+    delta=0;                      // delta - любое из R
+    beta=-delta + 2.0*atan2(-1.0/sqrt(2.0)*u3,
+                         1.0/sqrt(2.0)*u1);
+    }
+    else if (fabs(u4)<EPS && fabs(u2)<EPS && fabs(u3)>EPS)
+    {
+     gamma=-M_PI/2.0;
+     delta=0;           // delta - любое из R
+     beta=-delta-M_PI+2.0*atan2(1.0/sqrt(2.0)*u1,
+                                1.0/sqrt(2.0)*u3);
+    }
+    else;
+    // -----------------------------
+    if (fabs(u1)<EPS && fabs(u4)>EPS
+               && fabs(u2)<EPS && fabs(u3)>EPS)
+    {
+    beta=M_PI;
+    delta=0;
+    gamma = 2.0*atan2((u3-u4)/2.0,-(u3+u4)/2.0);
+    }
+    else;
+    // -----------------------------
+    if (fabs(u1)>EPS && fabs(u4)>EPS
+               && fabs(u2)<EPS && fabs(u3)<EPS)
+    {
+    beta = M_PI/2.0;
+    delta=-M_PI/2.0;
+    gamma = 2.0*atan2(-(u1+u4)/2.0, (u1-u4)/2.0);
+    }
+    else;
+    // ---------------------------------------------
+    if (fabs(u1)>EPS && fabs(u4)<EPS && fabs(u2)>EPS
+               && fabs(u3)<EPS)
+    {
+    beta=0;
+    delta=0;
+    // ---------------------------------------------
+    // Решение системы тригонометрических уравнений:
+    //  sin(gamma/2)=(u2-u1)/2;
+    //  cos(gamma/2)=(u2+u1)/2;
+    // -----------------------------------------
+    gamma = 2.0*atan2((u2-u1)/2.0, (u2+u1)/2.0);
+    }
+    else;
+    // ----------------------------------------------
+    if (fabs(u1)>EPS && fabs(u2)>EPS && fabs(u3)>EPS)
+                            // && fabs(u4)>EPS)
+    {
+    beta =-atan(u3/u1)-atan(u4/u2);
+    delta=-atan(u3/u1)+atan(u4/u2);
+    gamma = M_PI/2.0
+          + 2.0 * atan2(sqrt(2.0)/2.0 * u3/sin(beta/2+delta/2),
+                        sqrt(2.0)/2.0 * u2/cos(beta/2-delta/2));
+    }
+    else;
+    // -----------------------------
+    if (fabs(u1)<EPS && fabs(u4)<EPS
+               && fabs(u2)>EPS && fabs(u3)>EPS)
+    {
+    beta = M_PI/2.0;
+    delta= M_PI/2.0;
+    gamma= 2.0*atan2((u2+u3)/2.0, (u2-u3)/2.0);
+    }
+    else;
+    // -----------------------------
+    if (fabs(u1)<EPS && fabs(u4)>EPS
+               && fabs(u2)>EPS && fabs(u3)>EPS)
+    {
+    beta = M_PI/2.0 - atan(u4/u2);
+    delta= M_PI/2.0 + atan(u4/u2);
+    gamma=2.0*atan2(( u3 + u2/cos(beta/2.0-delta/2.0))/2.0,
+                (-u3 + u2/cos(beta/2.0-delta/2.0))/2.0);
+    }
+    else;
+    // -----------------------------
+    if (fabs(u1)>EPS && fabs(u4)>EPS
+               && fabs(u2)<EPS && fabs(u3)>EPS)
+    {
+    beta =M_PI/2.0 + atan(-u3/u1);
+    delta=-M_PI+beta;
+    gamma=2.0*atan2((-u1/cos(beta/2.0+delta/2.0)-u4)/2.0,
+                ( u1/cos(beta/2.0+delta/2.0)-u4)/2.0);
+    }
+    else;
+    // -----------------------------
+    if (fabs(u1)>EPS && fabs(u4)>EPS
+               && fabs(u2)>EPS && fabs(u3)<EPS)
+    {
+    beta =-atan(u4/u2);
+    delta=-beta;
+    gamma=2.0*atan2((-u4/sin(beta/2.0-delta/2.0)-u1)/2.0,
+                (-u4/sin(beta/2.0-delta/2.0)+u1)/2.0);
+    }
+    else;
+
+
+    decomposition dec;
+    dec.beta = beta;
+    dec.delta = delta;
+    dec.gamma = gamma;
+    return dec;
+}
+
+// clang-format on
+
+// Keeps v when keep is set and gives 0 otherwise; compiles to a select, not to a jump
+inline double masked(double v, bool keep) { return keep ? v : 0.0; }
+
+// e^{i alpha} Rz(beta) Ry(gamma) Rz(delta) = [[x, -conj(y)], [y, conj(x)]] e^{i alpha}.
+// alpha = arg(det) / 2; |x| = cos(gamma/2), arg x = -(beta+delta)/2, arg y = (beta-delta)/2.
+// For gamma = pi (x = 0) or gamma = 0 (y = 0) only one of beta +- delta is defined: the
+// undefined argument is masked to zero, i.e. delta = beta or delta = -beta.
+decomposition zyzRotations(double aRe, double aIm, double cRe, double cIm, double detRe,
+                           double detIm) {
+    double alpha = atan2(detIm, detRe) / 2.0;
+    double cosA = cos(alpha);
+    double sinA = sin(alpha);
+
+    double xRe = aRe * cosA + aIm * sinA;
+    double xIm = aIm * cosA - aRe * sinA;
+    double yRe = cRe * cosA + cIm * sinA;
+    double yIm = cIm * cosA - cRe * sinA;
+
+    double xAbs = sqrt(xRe * xRe + xIm * xIm);
+    double yAbs = sqrt(yRe * yRe + yIm * yIm);
+    double xArg = masked(atan2(xIm, xRe), xAbs > EPSILON);
+    double yArg = masked(atan2(yIm, yRe), yAbs > EPSILON);
+
+    decomposition dec;
+    dec.alpha = alpha;
+    dec.beta = yArg - xArg;
+    dec.delta = -xArg - yArg;
+    dec.gamma = 2.0 * atan2(yAbs, xAbs);
+    return dec;
+}
+
+decomposition fastRotations(DecompositionKernel::KIND kind, complex a, complex b, complex c,
+                            complex d) {
+    complex det = a * d - b * c;
+    complex x, y;
+
+    switch (kind) {
+    case DecompositionKernel::XY:
+        // Rx(t) = Ry(pi/2) Rz(t) Ry(-pi/2): decompose Ry(-pi/2) U Ry(pi/2)
+        x = (a + b + c + d) / 2.0;
+        y = (c + d - a - b) / 2.0;
+        break;
+    case DecompositionKernel::ZYX:
+        // Ry(g) Rx(t) = Ry(g + pi/2) Rz(t) Ry(-pi/2): decompose U Ry(pi/2)
+        x = (a + b) / sqrt(2.0);
+        y = (c + d) / sqrt(2.0);
+        break;
+    default:
+        x = a;
+        y = c;
+        break;
+    }
+
+    decomposition dec = zyzRotations(x.real(), x.imag(), y.real(), y.imag(), det.real(),
+                                     det.imag());
+    switch (kind) {
+    case DecompositionKernel::ZX:
+        // Rx(g) = Rz(-pi/2) Ry(g) Rz(pi/2)
+        dec.beta += M_PI / 2.0;
+        dec.delta -= M_PI / 2.0;
+        break;
+    case DecompositionKernel::ZYX:
+        dec.gamma -= M_PI / 2.0;
+        break;
+    default:
+        break;
+    }
+    return dec;
+}
+
+// Arguments of rotations() / zyxRotations() for the given kind of decomposition
+void caseArguments(DecompositionKernel::KIND kind, double a1, double a2, double b1, double b2,
+                   double *p) {
+    switch (kind) {
+    case DecompositionKernel::ZX:
+        p[0] = a1;
+        p[1] = b1;
+        p[2] = b2;
+        p[3] = a2;
+        break;
+    case DecompositionKernel::ZY:
+        p[0] = a1;
+        p[1] = -b2;
+        p[2] = b1;
+        p[3] = a2;
+        break;
+    case DecompositionKernel::XY:
+        p[0] = a1;
+        p[1] = a2;
+        p[2] = b1;
+        p[3] = b2;
+        break;
+    case DecompositionKernel::ZYX:
+        p[0] = a1 + b1;
+        p[1] = a1 - b1;
+        p[2] = a2 + b2;
+        p[3] = a2 - b2;
+        break;
+    }
+}
+
+decomposition caseRotations(DecompositionKernel::KIND kind, const double *p) {
+    if (kind == DecompositionKernel::ZYX) {
+        return zyxRotations(p[0], p[1], p[2], p[3]);
+    }
+    return rotations(p[0], p[1], p[2], p[3]);
+}
+
+// Case of the cascade: bit j is set when |p[j]| > EPSILON
+void classifyScalar(const double *const p[4], unsigned char *cases, std::size_t from,
+                    std::size_t n) {
+    for (std::size_t k = from; k < n; ++k) {
+        cases[k] = static_cast<unsigned char>(
+            (std::abs(p[0][k]) > EPSILON) | (std::abs(p[1][k]) > EPSILON) << 1 |
+            (std::abs(p[2][k]) > EPSILON) << 2 | (std::abs(p[3][k]) > EPSILON) << 3);
+    }
+}
+
+#ifdef BLOCH_SSE2
+std::size_t classifySse2(const double *const p[4], unsigned char *cases, std::size_t n) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d eps = _mm_set1_pd(EPSILON);
+    std::size_t   k = 0;
+    for (; k + 2 <= n; k += 2) {
+        int mask[4];
+        for (int j = 0; j < 4; ++j) {
+            __m128d v = _mm_andnot_pd(sign, _mm_loadu_pd(p[j] + k));
+            mask[j] = _mm_movemask_pd(_mm_cmpgt_pd(v, eps));
+        }
+        for (int l = 0; l < 2; ++l) {
+            cases[k + l] =
+                static_cast<unsigned char>((mask[0] >> l & 1) | (mask[1] >> l & 1) << 1 |
+                                           (mask[2] >> l & 1) << 2 | (mask[3] >> l & 1) << 3);
+        }
+    }
+    return k;
+}
+#endif
+
+#ifdef BLOCH_AVX2
+__attribute__((target("avx2"))) std::size_t classifyAvx2(const double *const p[4],
+                                                          unsigned char *cases, std::size_t n) {
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d eps = _mm256_set1_pd(EPSILON);
+    std::size_t   k = 0;
+    for (; k + 4 <= n; k += 4) {
+        int mask[4];
+        for (int j = 0; j < 4; ++j) {
+            __m256d v = _mm256_andnot_pd(sign, _mm256_loadu_pd(p[j] + k));
+            mask[j] = _mm256_movemask_pd(_mm256_cmp_pd(v, eps, _CMP_GT_OQ));
+        }
+        for (int l = 0; l < 4; ++l) {
+            cases[k + l] =
+                static_cast<unsigned char>((mask[0] >> l & 1) | (mask[1] >> l & 1) << 1 |
+                                           (mask[2] >> l & 1) << 2 | (mask[3] >> l & 1) << 3);
+        }
+    }
+    return k;
+}
+
+bool hasAvx2() {
+    static const bool avx2 = __builtin_cpu_supports("avx2");
+    return avx2;
+}
+#endif
+
+void classify(const double *const p[4], unsigned char *cases, std::size_t n) {
+    std::size_t k = 0;
+#ifdef BLOCH_AVX2
+    if (hasAvx2()) {
+        k = classifyAvx2(p, cases, n);
+    }
+#endif
+#ifdef BLOCH_SSE2
+    if (k == 0) {
+        k = classifySse2(p, cases, n);
+    }
+#endif
+    classifyScalar(p, cases, k, n);
+}
+} // namespace
+
+namespace DecompositionKernel {
+ENGINE getEngine() { return engine; }
+void   setEngine(ENGINE e) { engine = e; }
+
+ENGINE engineByName(const QString &name, bool *ok) {
+    for (int e = LEGACY; e <= FAST; ++e) {
+        if (name.compare(ENGINE_NAMES[e], Qt::CaseInsensitive) == 0) {
+            *ok = true;
+            return static_cast<ENGINE>(e);
+        }
+    }
+    *ok = false;
+    return LEGACY;
+}
+
+decomposition decompose(KIND kind, complex a, complex b, complex c, complex d) {
+    if (getEngine() == FAST) {
+        return decomposeFast(kind, a, b, c, d);
+    }
+    return decomposeLegacy(kind, a, b, c, d);
+}
+
+decomposition decomposeFast(KIND kind, complex a, complex b, complex c, complex d) {
+    return fastRotations(kind, a, b, c, d);
+}
+
+decomposition decomposeLegacy(KIND kind, complex a, complex b, complex c, complex d) {
+    double alpha = alphaAngle(a, b, c, d);
+    double a1, a2, b1, b2;
+    halfAngles(a, b, c, d, alpha, a1, a2, b1, b2);
+
+    double p[4];
+    caseArguments(kind, a1, a2, b1, b2, p);
+    decomposition dec = caseRotations(kind, p);
+    dec.alpha = alpha;
+    return dec;
+}
+
+void decompose(KIND kind, const matrix2x2batch &ops, const decompositionbatch &decs,
+               std::size_t n) {
+    if (getEngine() == FAST) {
+        for (std::size_t i = 0; i < n; ++i) {
+            decomposition dec = fastRotations(kind, complex(ops.aRe[i], ops.aIm[i]),
+                                              complex(ops.bRe[i], ops.bIm[i]),
+                                              complex(ops.cRe[i], ops.cIm[i]),
+                                              complex(ops.dRe[i], ops.dIm[i]));
+            decs.alpha[i] = dec.alpha;
+            decs.beta[i] = dec.beta;
+            decs.delta[i] = dec.delta;
+            decs.gamma[i] = dec.gamma;
+        }
+        return;
+    }
+
+    double         args[4][BLOCK_SIZE];
+    unsigned char  cases[BLOCK_SIZE];
+    unsigned short order[BLOCK_SIZE];
+    const double  *p[4] = {args[0], args[1], args[2], args[3]};
+
+    for (std::size_t first = 0; first < n; first += BLOCK_SIZE) {
+        std::size_t size = n - first < BLOCK_SIZE ? n - first : BLOCK_SIZE;
+
+        for (std::size_t k = 0; k < size; ++k) {
+            std::size_t i = first + k;
+            complex     a(ops.aRe[i], ops.aIm[i]);
+            complex     b(ops.bRe[i], ops.bIm[i]);
+            complex     c(ops.cRe[i], ops.cIm[i]);
+            complex     d(ops.dRe[i], ops.dIm[i]);
+
+            double alpha = alphaAngle(a, b, c, d);
+            double a1, a2, b1, b2;
+            halfAngles(a, b, c, d, alpha, a1, a2, b1, b2);
+
+            double q[4];
+            caseArguments(kind, a1, a2, b1, b2, q);
+            args[0][k] = q[0];
+            args[1][k] = q[1];
+            args[2][k] = q[2];
+            args[3][k] = q[3];
+            decs.alpha[i] = alpha;
+        }
+
+        classify(p, cases, size);
+
+        // counting sort of the block by case
+        std::size_t start[COUNT_OF_CASES + 1] = {0};
+        for (std::size_t k = 0; k < size; ++k) {
+            ++start[cases[k] + 1];
+        }
+        for (int c = 0; c < COUNT_OF_CASES; ++c) {
+            start[c + 1] += start[c];
+        }
+        for (std::size_t k = 0; k < size; ++k) {
+            order[start[cases[k]]++] = static_cast<unsigned short>(k);
+        }
+
+        for (std::size_t j = 0; j < size; ++j) {
+            std::size_t   k = order[j];
+            double        q[4] = {args[0][k], args[1][k], args[2][k], args[3][k]};
+            decomposition dec = caseRotations(kind, q);
+            decs.beta[first + k] = dec.beta;
+            decs.delta[first + k] = dec.delta;
+            decs.gamma[first + k] = dec.gamma;
+        }
+    }
+}
+} // namespace DecompositionKernel
@@ -0,0 +1,85 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef DECOMPOSITIONKERNEL_HPP
+#define DECOMPOSITIONKERNEL_HPP
+
+#include "src/utility.h"
+#include <cstddef>
+
+struct decomposition {
+    double alpha = 0; // rad
+    double beta = 0;  // rad
+    double delta = 0; // rad
+    double gamma = 0; // rad
+
+    void print(std::ostream &out) const {
+        out << "----------------------------------------------\n";
+        out << "alpha: " << alpha * 180 / M_PI << "\n";
+        out << "beta: " << beta * 180 / M_PI << "\n";
+        out << "delta: " << delta * 180 / M_PI << "\n";
+        out << "gamma: " << gamma * 180 / M_PI << "\n";
+        out << "----------------------------------------------\n";
+    }
+};
+
+// Structure-of-arrays view of a batch of operators: the k-th operator is
+// a = aRe[k] + i * aIm[k], b = bRe[k] + i * bIm[k], ...
+struct matrix2x2batch {
+    const double *aRe;
+    const double *aIm;
+    const double *bRe;
+    const double *bIm;
+    const double *cRe;
+    const double *cIm;
+    const double *dRe;
+    const double *dIm;
+};
+
+struct decompositionbatch {
+    double *alpha;
+    double *beta;
+    double *delta;
+    double *gamma;
+};
+
+namespace DecompositionKernel {
+enum KIND { ZX = 0, ZY, XY, ZYX };
+
+// LEGACY is the case cascade of the original decompositions. FAST is a single closed-form Z-Y-Z
+// decomposition (the other kinds are reduced to it by rotating the axes) whose degenerate
+// gamma = 0 / pi cases are masked instead of branched on. Both give valid decompositions, but
+// not the same angles when the decomposition is not unique.
+enum ENGINE { LEGACY = 0, FAST };
+
+ENGINE getEngine();
+void   setEngine(ENGINE e);
+// "legacy" or "fast" in any case
+ENGINE engineByName(const QString &name, bool *ok);
+
+decomposition decompose(KIND kind, complex a, complex b, complex c, complex d);
+decomposition decomposeLegacy(KIND kind, complex a, complex b, complex c, complex d);
+decomposition decomposeFast(KIND kind, complex a, complex b, complex c, complex d);
+
+// Uses the current engine and gives the same bits as the scalar decompose() for every operator.
+// LEGACY: transcendental stages are evaluated per operator with libm; the SIMD part classifies
+// operators by the case of the decomposition and runs them grouped by case, so the case cascade
+// is predicted well. FAST: one straight-line loop over the operators.
+void decompose(KIND kind, const matrix2x2batch &ops, const decompositionbatch &decs,
+               std::size_t n);
+} // namespace DecompositionKernel
+
+#endif // DECOMPOSITIONKERNEL_HPP
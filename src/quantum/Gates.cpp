@@ -0,0 +1,67 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Gates.h"
+#include <QHash>
+
+namespace Gates {
+decomposition getDecomposition(GATE g, DecompositionKernel::KIND kind) {
+    const gate   &entry = TABLE[g];
+    const double *angles = entry.zy;
+    switch (kind) {
+    case DecompositionKernel::ZX:
+        angles = entry.zx;
+        break;
+    case DecompositionKernel::ZY:
+        angles = entry.zy;
+        break;
+    case DecompositionKernel::XY:
+        angles = entry.xy;
+        break;
+    case DecompositionKernel::ZYX:
+        angles = entry.zyx;
+        break;
+    }
+
+    decomposition dec;
+    dec.alpha = angles[0];
+    dec.beta = angles[1];
+    dec.delta = angles[2];
+    dec.gamma = angles[3];
+    return dec;
+}
+
+GATE findGate(const UnitaryMatrix2x2 &op) {
+    static const QHash<canonicalmatrix, int> gates = [] {
+        QHash<canonicalmatrix, int> h;
+        for (int g = ID; g < COUNT; ++g) {
+            h.insert(UnitaryMatrix2x2::getGate(g).getCanonical(), g);
+        }
+        return h;
+    }();
+    GATE g = static_cast<GATE>(gates.value(op.getCanonical(), NONE));
+    if (g != NONE) {
+        return g;
+    }
+    // Entries typed with a few digits, or rounding noise across a grid boundary, miss the key
+    for (int k = ID; k < COUNT; ++k) {
+        if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getGate(k), op, false)) {
+            return static_cast<GATE>(k);
+        }
+    }
+    return NONE;
+}
+} // namespace Gates
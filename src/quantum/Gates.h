@@ -0,0 +1,101 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef GATES_HPP
+#define GATES_HPP
+
+#include "DecompositionKernel.h"
+#include "UnitaryMatrix2x2.h"
+
+// Named gates with everything the program derives from them worked out ahead of time, so an
+// operator set to one of them needs neither a decomposition nor a name lookup. The angles are
+// those of the legacy decompositions with rounding noise removed and reduced to (-pi, pi].
+namespace Gates {
+enum GATE { NONE = -1, ID = 0, X, Y, Z, H, S, T, COUNT };
+
+struct gate {
+    const char *name;
+    matrix2x2   matrix;
+    // alpha, beta, delta, gamma (rad)
+    double zx[4];
+    double zy[4];
+    double xy[4];
+    double zyx[4];
+    // Rotation axis x, y, z and angle (rad)
+    double axisAngle[4];
+};
+
+constexpr double PI = M_PI;
+constexpr double SQRT1_2 = 0.70710678118654752440;
+
+constexpr gate TABLE[COUNT] = {
+    {"Id",
+     {1, 0, 0, 1},
+     {0, 0, 0, 0},
+     {0, 0, 0, 0},
+     {0, 0, 0, 0},
+     {0, 0, 0, 0},
+     {0, 0, 0, 0}},
+    {"X",
+     {0, 1, 1, 0},
+     {PI / 2, 0, 0, PI},
+     {PI / 2, 0, PI, PI},
+     {PI / 2, PI, 0, 0},
+     {PI / 2, PI, 0, PI},
+     {1, 0, 0, PI}},
+    {"Y",
+     {0, complex(0, -1), complex(0, 1), 0},
+     {PI / 2, 0, PI, PI},
+     {PI / 2, 0, 0, PI},
+     {PI / 2, 0, 0, PI},
+     {PI / 2, 0, 0, PI},
+     {0, 1, 0, PI}},
+    {"Z",
+     {1, 0, 0, -1},
+     {PI / 2, PI, 0, 0},
+     {PI / 2, PI, 0, 0},
+     {PI / 2, 0, PI, PI},
+     {PI / 2, PI, 0, 0},
+     {0, 0, 1, PI}},
+    {"H",
+     {SQRT1_2, SQRT1_2, SQRT1_2, -SQRT1_2},
+     {PI / 2, PI / 2, PI / 2, PI / 2},
+     {PI / 2, PI, 0, -PI / 2},
+     {PI / 2, PI, 0, PI / 2},
+     {PI / 2, PI, 0, -PI / 2},
+     {SQRT1_2, 0, SQRT1_2, PI}},
+    {"S",
+     {1, 0, 0, complex(0, 1)},
+     {PI / 4, PI / 2, 0, 0},
+     {PI / 4, PI / 2, 0, 0},
+     {PI / 4, PI / 2, -PI / 2, PI / 2},
+     {PI / 4, PI / 2, 0, 0},
+     {0, 0, 1, PI / 2}},
+    {"T",
+     {1, 0, 0, complex(SQRT1_2, SQRT1_2)},
+     {PI / 8, PI / 4, 0, 0},
+     {PI / 8, PI / 4, 0, 0},
+     {PI / 8, PI / 2, -PI / 2, PI / 4},
+     {PI / 8, PI / 4, 0, 0},
+     {0, 0, 1, PI / 4}},
+};
+
+decomposition getDecomposition(GATE g, DecompositionKernel::KIND kind);
+// Gate equal to op up to phase within the tolerance of compareOperators(), or NONE
+GATE findGate(const UnitaryMatrix2x2 &op);
+} // namespace Gates
+
+#endif // GATES_HPP
@@ -15,180 +15,183 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Operator.h"
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
 
-Operator::Operator() { toId(); }
+namespace {
+const int DEFAULT_CACHE_CAPACITY = 1024;
+// Kind of the cached vectorAngleDec() next to DecompositionKernel::KIND
+const int VECTOR_ANGLE = DecompositionKernel::ZYX + 1;
+
+struct cachekey {
+    canonicalmatrix matrix;
+    int             kind;
+    int             engine;
 
-QVector<Spike> Operator::rotate(Spike s, QVector3D v, double gamma) {
-    QVector<Spike> trace;
-    trace.append(s);
-    for (uint i = 1; i < Utility::getDuration(); ++i) {
-        QQuaternion q = QQuaternion::fromAxisAndAngle(
-            v, static_cast<float>(i / Utility::getDuration() * gamma * 180 / M_PI));
-        trace.append(Vector::actOperator(q, s));
+    bool operator==(const cachekey &key) const {
+        return matrix == key.matrix && kind == key.kind && engine == key.engine;
     }
-    QQuaternion q = QQuaternion::fromAxisAndAngle(v, static_cast<float>(gamma * 180 / M_PI));
-    trace.append(Vector::actOperator(q, s));
-    return trace;
-}
+};
 
-QVector<Spike> Operator::rXRotate(Spike s, double gamma) {
-    return rotate(s, QVector3D(1, 0, 0), gamma);
+uint qHash(const cachekey &key, uint seed = 0) {
+    return ::qHash(key.matrix, seed ^ uint(key.kind << 1 | key.engine));
 }
 
-QVector<Spike> Operator::rYRotate(Spike s, double gamma) {
-    return rotate(s, QVector3D(0, 1, 0), gamma);
-}
+// Decompositions are stored with the global phase of the canonical matrix taken out of alpha
+struct cachevalue {
+    decomposition dec;
+    vectorangle   va;
+};
 
-QVector<Spike> Operator::rZRotate(Spike s, double gamma) {
-    return rotate(s, QVector3D(0, 0, 1), gamma);
+QMutex                       cacheMutex;
+QCache<cachekey, cachevalue> cache(DEFAULT_CACHE_CAPACITY);
+cachestatistics              statistics;
+
+// Copies the cached entry for key into value; returns false on a miss
+bool lookUp(cachekey key, cachevalue &value) {
+    QMutexLocker locker(&cacheMutex);
+    cachevalue  *cached = cache.object(key);
+    if (cached) {
+        ++statistics.hits;
+        value = *cached;
+        return true;
+    }
+    ++statistics.misses;
+    return false;
 }
 
-QVector<Spike> Operator::applyZxDecomposition(Spike s, UnitaryMatrix2x2 op) {
-    QVector<Spike> spike = {s};
-    decomposition  dec = zxDecomposition(op);
+void store(cachekey key, const cachevalue &value) {
+    QMutexLocker locker(&cacheMutex);
+    cache.insert(key, new cachevalue(value));
+}
 
-    if (dec.delta != 0) {
-        QVector<Spike> vct = rZRotate(spike.last(), dec.delta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
+decomposition cachedDecomposition(DecompositionKernel::KIND kind, const UnitaryMatrix2x2 &op,
+                                  decomposition (*decompose)(UnitaryMatrix2x2)) {
+    cachekey   key = {op.getCanonical(), kind, DecompositionKernel::getEngine()};
+    double     phase = op.getCanonicalPhase();
+    cachevalue value;
+    if (not lookUp(key, value)) {
+        value.dec = decompose(op);
+        value.dec.alpha -= phase;
+        store(key, value);
     }
+    // Restored the same way on a miss as on a hit, so every call gives the same alpha
+    value.dec.alpha = std::remainder(value.dec.alpha + phase, 2 * M_PI);
+    return value.dec;
+}
 
-    if (dec.gamma != 0) {
-        QVector<Spike> vct = rXRotate(spike.last(), dec.gamma);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
+vectorangle cachedVectorAngle(const UnitaryMatrix2x2 &op) {
+    cachekey   key = {op.getCanonical(), VECTOR_ANGLE, DecompositionKernel::getEngine()};
+    cachevalue value;
+    if (!lookUp(key, value)) {
+        value.va = Operator::vectorAngleDec(op);
+        store(key, value);
     }
+    return value.va;
+}
+} // namespace
 
-    if (dec.beta != 0) {
-        QVector<Spike> vct = rZRotate(spike.last(), dec.beta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
+Operator::Operator() { toId(); }
 
-    std::reverse(spike.begin(), spike.end());
-    return spike;
+cachestatistics Operator::getCacheStatistics() {
+    QMutexLocker    locker(&cacheMutex);
+    cachestatistics s = statistics;
+    s.size = cache.size();
+    s.capacity = cache.maxCost();
+    return s;
 }
 
-QVector<Spike> Operator::applyZyDecomposition(Spike s, UnitaryMatrix2x2 op) {
-    QVector<Spike> spike = {s};
-    decomposition  dec = zyDecomposition(op);
-    if (dec.delta != 0) {
-        QVector<Spike> vct = rZRotate(spike.last(), dec.delta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
-
-    if (dec.gamma != 0) {
-        QVector<Spike> vct = rYRotate(spike.last(), dec.gamma);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
+void Operator::setCacheCapacity(int capacity) {
+    QMutexLocker locker(&cacheMutex);
+    cache.setMaxCost(capacity);
+}
 
-    if (dec.beta != 0) {
-        QVector<Spike> vct = rZRotate(spike.last(), dec.beta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
+void Operator::clearCache() {
+    QMutexLocker locker(&cacheMutex);
+    cache.clear();
+    statistics = cachestatistics();
+}
 
-    std::reverse(spike.begin(), spike.end());
-    return spike;
+Path Operator::rotate(Spike s, Vector3D v, double gamma) {
+    Path path(s);
+    path.addRotation(v, gamma);
+    return path;
 }
 
-QVector<Spike> Operator::applyXyDecomposition(Spike s, UnitaryMatrix2x2 op) {
-    QVector<Spike> spike = {s};
-    decomposition  dec = xyDecomposition(op);
+Path Operator::rXRotate(Spike s, double gamma) { return rotate(s, Vector3D(1, 0, 0), gamma); }
+
+Path Operator::rYRotate(Spike s, double gamma) { return rotate(s, Vector3D(0, 1, 0), gamma); }
 
+Path Operator::rZRotate(Spike s, double gamma) { return rotate(s, Vector3D(0, 0, 1), gamma); }
+
+// Rotations by delta, gamma and beta about the first, second and third axes; zero angles are
+// skipped
+Path decompositionPath(Spike s, decomposition dec, Vector3D first, Vector3D second,
+                       Vector3D third) {
+    Path path(s);
     if (dec.delta != 0) {
-        QVector<Spike> vct = rXRotate(spike.last(), dec.delta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
+        path.addRotation(first, dec.delta);
     }
-
     if (dec.gamma != 0) {
-        QVector<Spike> vct = rYRotate(spike.last(), dec.gamma);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
+        path.addRotation(second, dec.gamma);
     }
-
     if (dec.beta != 0) {
-        QVector<Spike> vct = rXRotate(spike.last(), dec.beta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
+        path.addRotation(third, dec.beta);
     }
+    return path;
+}
 
-    std::reverse(spike.begin(), spike.end());
-    return spike;
+Path zxPath(Spike s, decomposition dec) {
+    return decompositionPath(s, dec, Vector3D(0, 0, 1), Vector3D(1, 0, 0), Vector3D(0, 0, 1));
 }
 
-QVector<Spike> Operator::applyZyxDecomposition(Spike s, UnitaryMatrix2x2 op) {
-    QVector<Spike> spike = {s};
-    decomposition  dec = zyxDecomposition(op);
+Path zyPath(Spike s, decomposition dec) {
+    return decompositionPath(s, dec, Vector3D(0, 0, 1), Vector3D(0, 1, 0), Vector3D(0, 0, 1));
+}
 
-    if (dec.delta != 0) {
-        QVector<Spike> vct = rXRotate(spike.last(), dec.delta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
+Path xyPath(Spike s, decomposition dec) {
+    return decompositionPath(s, dec, Vector3D(1, 0, 0), Vector3D(0, 1, 0), Vector3D(1, 0, 0));
+}
 
-    if (dec.gamma != 0) {
-        QVector<Spike> vct = rYRotate(spike.last(), dec.gamma);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
+Path zyxPath(Spike s, decomposition dec) {
+    return decompositionPath(s, dec, Vector3D(1, 0, 0), Vector3D(0, 1, 0), Vector3D(0, 0, 1));
+}
 
-    if (dec.beta != 0) {
-        QVector<Spike> vct = rZRotate(spike.last(), dec.beta);
-        for (auto &e : vct) {
-            spike.append(e);
-        }
-    }
+Path Operator::applyZxDecomposition(Spike s, UnitaryMatrix2x2 op) {
+    return zxPath(s, zxDecomposition(op));
+}
 
-    std::reverse(spike.begin(), spike.end());
-    return spike;
+Path Operator::applyZyDecomposition(Spike s, UnitaryMatrix2x2 op) {
+    return zyPath(s, zyDecomposition(op));
 }
 
-QVector<Spike> Operator::applyOperator(Spike s, UnitaryMatrix2x2 op) {
-    QVector<Spike> spike = {s};
-    if (Operator::getOperatorName(op) == "Id") {
-        return spike;
-    }
+Path Operator::applyXyDecomposition(Spike s, UnitaryMatrix2x2 op) {
+    return xyPath(s, xyDecomposition(op));
+}
 
-    decomposition dec = zyDecomposition(op);
-    QVector3D     zVector = QVector3D(0, 0, 1);
-    QVector3D     xVector = QVector3D(1, 0, 0);
-    QQuaternion   qz1 = QQuaternion::fromAxisAndAngle(zVector, static_cast<float>(dec.beta));
-    QQuaternion   qx = QQuaternion::fromAxisAndAngle(xVector, static_cast<float>(dec.gamma));
-    QQuaternion   qz2 = QQuaternion::fromAxisAndAngle(zVector, static_cast<float>(dec.delta));
-    QQuaternion   q = qz1 * qx * qz2;
-
-    QVector3D v = q.vector().normalized();
-    double    g = qFuzzyIsNull(v.length()) ? 0 : 2 * qAcos(q.scalar()) * 180 / M_PI;
-    if (qFuzzyIsNull(g)) {
-        g = g > 0 ? 180 : -180;
-    }
+Path Operator::applyZyxDecomposition(Spike s, UnitaryMatrix2x2 op) {
+    return zyxPath(s, zyxDecomposition(op));
+}
 
-    if (not qFuzzyIsNull(g)) {
-        for (uint i = 1; i < Utility::getDuration(); ++i) {
-            QQuaternion qq = QQuaternion::fromAxisAndAngle(
-                v, static_cast<float>(i / Utility::getDuration() * g));
-            spike.append(Vector::actOperator(qq, s));
-        }
+// Rotation by the quaternion q in one turn about its axis
+Path quaternionPath(Spike s, const Quaternion &q) {
+    Path     path(s);
+    Vector3D axis;
+    double   angle = 0;
+    q.getAxisAndAngle(&axis, &angle);
+    if (angle != 0) {
+        path.addRotation(axis, angle * M_PI / 180);
+        path.setLast(Vector::actOperator(q, s));
     }
-    spike.append(Vector::actOperator(q, s));
+    return path;
+}
 
-    std::reverse(spike.begin(), spike.end());
-    return spike;
+Path Operator::applyOperator(Spike s, UnitaryMatrix2x2 op) {
+    if (Operator::getOperatorName(op) == "Id") {
+        return Path(s);
+    }
+    return quaternionPath(s, op.toQuaternion());
 }
 
 QString getComplexStr(complex a) {
@@ -200,684 +203,74 @@ QString getComplexStr(complex a) {
 }
 
 decomposition Operator::zxDecomposition(UnitaryMatrix2x2 op) {
-    complex i = complex(0, 1);
-    double  alpha = 0;
-    double  beta = 0;
-    double  delta = 0;
-    double  gamma = 0;
-    complex a = op.a();
-    complex b = op.b();
-    complex c = op.c();
-    complex d = op.d();
-    double EPS = EPSILON;
-
-    // Author  : Швецкий Михаил Владимирович
-    // clang-format off
-
-    // ****************************
-    // Вычисление Z-Y-разложения...
-    // ----------------------------
-    // Корректировка значения alpha
-    // ----------------------------
-    if (abs(d)>EPS)
-      if (abs(complex(1)+a/conj(d))<EPS)
-        alpha=M_PI/2.0;
-      else alpha=arg(a/conj(d))/2.0;
-         else if (abs(c)>EPS)
-           if (abs(complex(1)-b/conj(c))<EPS)
-             alpha=M_PI/2.0;
-           else alpha=arg(-b/conj(c))/2.0;
-    // -----------------------------------
-    complex A, B;
-    double a1, a2, b1, b2;
-    A = (exp(-i*alpha)*(a+b) + exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-    B = (exp(-i*alpha)*(a+b) - exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-
-    a1 = real(A); a2 = imag(A); b1 = real(B); b2 = imag(B);
-
-    double a1n=a1, a2n=a2, b1n=b1, b2n=b2;
-    a1=a1n; a2=b1n; b1=b2n; b2=a2n;       // Для Z-X-разложения
-    // ------------------------------
-    if (fabs(a1)<EPS && fabs(b2)<EPS)
-      if (fabs(b1)>EPS)                     // a1=0, a2=?, b1!=0, b2=0
-      {
-        delta=0;                            // delta - любое из R
-        beta=delta + 2.0*atan2(-a2,-b1);
-        gamma=M_PI;
-      }
-      else if (fabs(a2)>EPS)                // a1=0, a2!=0, b1=?, b2=0
-           {
-             delta= M_PI;                   // delta - любое из R
-             beta = delta-M_PI+2.0*atan2(-b1,a2);
-             gamma= M_PI;
-           }
-           else;
-    // ------------------------------
-    if (fabs(a2)<EPS && fabs(b1)<EPS)
-      if (fabs(a1)>EPS)                     // a1!=0, a2=0, b1=0, b2=?
-      {
-        delta=0;                            // delta - любое из R
-        beta=-delta + 2.0*atan2(-b2,a1);
-        gamma=0;
-      }
-      else if (fabs(b2)>EPS)                // a1=?, a2=0, b1=0, b2!=0
-           {
-             delta=0;                       // delta - любое из R
-             beta =-delta-M_PI+2.0*atan2(a1,b2);
-             gamma=0;
-           }
-           else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                     && fabs(b2)>EPS)       // a1=0, a2!=0, b1=0, b2!=0
-    {
-      beta=M_PI;
-      gamma=2.0*atan2(-a2,-b2);
-      delta=0;
-    }
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                     && fabs(b2)<EPS)       // a1!=0, a2!=0, b1=0, b2=0
-    {
-      beta=M_PI/2.0;
-      gamma=2.0*atan2(-a2,a1);
-      delta=-M_PI/2.0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                     && fabs(b2)<EPS)       // a1!=0, a2=0, b1!=0, b2=0
-    {
-      beta=0;
-      gamma=2.0*atan2(-b1,a1);
-      delta=0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1!=0, a2=0, b1!=0, b2!=0
-    {
-      beta=atan(-b2/a1);
-      gamma=2.0*atan2(-b1,-b2/sin(beta));
-      delta=beta;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1!=0, a2!=0, b1!=0, b2!=0
-    {
-      beta =atan(-b2/a1)+atan(a2/b1);
-      delta=atan(-b2/a1)-atan(a2/b1);
-      gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
-                      a1/cos(beta/2.0+delta/2.0));
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                     && fabs(b2)<EPS)       // a1!=0, a2!=0, b1!=0, b2=0
-    {
-      beta =atan(-b2/a1)+atan(a2/b1);
-      delta=atan(-b2/a1)-atan(a2/b1);
-      gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
-                      a1/cos(beta/2.0+delta/2.0));
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1=0, a2=0, b1!=0, b2!=0
-    {
-      beta=M_PI/2.0;
-      gamma=2.0*atan2(-b1,-b2);
-      delta=M_PI/2.0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1=0, a2!=0, b1!=0, b2!=0
-    {
-      beta  = M_PI/2.0 + atan(a2/b1);
-      delta = M_PI-beta;
-      gamma = 2.0*atan2(-b1/cos(beta/2.0-delta/2.0),-b2);
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                     && fabs(b2)>EPS)       // a1!=0, a2!=0, b1=0, b2!=0
-    {
-      beta  = M_PI/2.0 + atan(-b2/a1);
-      delta = -M_PI + beta;
-      gamma = 2.0*atan2(-a2, -b2/sin(beta/2.0+delta/2.0));
-    }
-    else;
-
-    // clang-format on
-
-    decomposition dec;
-    dec.alpha = alpha;
-    dec.beta = beta;
-    dec.delta = delta;
-    dec.gamma = gamma;
-    return dec;
+    return DecompositionKernel::decompose(DecompositionKernel::ZX, op.a(), op.b(), op.c(), op.d());
 }
 
-decomposition Operator::zxDecomposition() { return zxDecomposition(_op); }
-
-decomposition Operator::zyDecomposition(UnitaryMatrix2x2 op) {
-    complex i = complex(0, 1);
-    double  alpha = 0;
-    double  beta = 0;
-    double  delta = 0;
-    double  gamma = 0;
-    complex a = op.a();
-    complex b = op.b();
-    complex c = op.c();
-    complex d = op.d();
-    double EPS = EPSILON;
-
-    // Author  : Швецкий Михаил Владимирович
-    // clang-format off
-
-    // ****************************
-    // Вычисление Z-Y-разложения...
-    // ----------------------------
-    // Корректировка значения alpha
-    // ----------------------------
-    if (abs(d)>EPS)
-    if (abs(complex(1)+a/conj(d))<EPS)
-    alpha=M_PI/2.0;
-    else alpha=arg(a/conj(d))/2.0;
-     else if (abs(c)>EPS)
-       if (abs(complex(1)-b/conj(c))<EPS)
-         alpha=M_PI/2.0;
-       else alpha=arg(-b/conj(c))/2.0;
-    // -----------------------------------
-    complex A, B;
-    double a1, a2, b1, b2;
-    A = (exp(-i*alpha)*(a+b) + exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-    B = (exp(-i*alpha)*(a+b) - exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-
-    a1 = real(A); a2 = imag(A); b1 = real(B); b2 = imag(B);
-
-    double a1n=a1, a2n=a2, b1n=b1, b2n=b2;
-    a1=a1n; a2=-b2n; b1=b1n; b2=a2n;       // Для Z-Y-разложения
-    // ------------------------------
-    if (fabs(a1)<EPS && fabs(b2)<EPS)
-    if (fabs(b1)>EPS)                     // a1=0, a2=?, b1!=0, b2=0
-    {
-    delta=0;                            // delta - любое из R
-    beta=delta + 2.0*atan2(-a2,-b1);
-    gamma=M_PI;
-    }
-    else if (fabs(a2)>EPS)                // a1=0, a2!=0, b1=?, b2=0
-       {
-         delta= M_PI;                   // delta - любое из R
-         beta = delta-M_PI+2.0*atan2(-b1,a2);
-         gamma= M_PI;
-       }
-       else;
-    // ------------------------------
-    if (fabs(a2)<EPS && fabs(b1)<EPS)
-    if (fabs(a1)>EPS)                     // a1!=0, a2=0, b1=0, b2=?
-    {
-    delta=0;                            // delta - любое из R
-    beta=-delta + 2.0*atan2(-b2,a1);
-    gamma=0;
-    }
-    else if (fabs(b2)>EPS)                // a1=?, a2=0, b1=0, b2!=0
-       {
-         delta=0;                       // delta - любое из R
-         beta =-delta-M_PI+2.0*atan2(a1,b2);
-         gamma=0;
-       }
-       else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                 && fabs(b2)>EPS)       // a1=0, a2!=0, b1=0, b2!=0
-    {
-    beta=M_PI;
-    gamma=2.0*atan2(-a2,-b2);
-    delta=0;
-    }
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                 && fabs(b2)<EPS)       // a1!=0, a2!=0, b1=0, b2=0
-    {
-    beta=M_PI/2.0;
-    gamma=2.0*atan2(-a2,a1);
-    delta=-M_PI/2.0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                 && fabs(b2)<EPS)       // a1!=0, a2=0, b1!=0, b2=0
-    {
-    beta=0;
-    gamma=2.0*atan2(-b1,a1);
-    delta=0;
+decomposition Operator::zxDecomposition() {
+    if (_gate != Gates::NONE) {
+        return Gates::getDecomposition(_gate, DecompositionKernel::ZX);
     }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                 && fabs(b2)>EPS)       // a1!=0, a2=0, b1!=0, b2!=0
-    {
-    beta=atan(-b2/a1);
-    gamma=2.0*atan2(-b1,-b2/sin(beta));
-    delta=beta;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                 && fabs(b2)>EPS)       // a1!=0, a2!=0, b1!=0, b2!=0
-    {
-    beta =atan(-b2/a1)+atan(a2/b1);
-    delta=atan(-b2/a1)-atan(a2/b1);
-    gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
-                  a1/cos(beta/2.0+delta/2.0));
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                 && fabs(b2)<EPS)       // a1!=0, a2!=0, b1!=0, b2=0
-    {
-    beta =atan(-b2/a1)+atan(a2/b1);
-    delta=atan(-b2/a1)-atan(a2/b1);
-    gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
-                  a1/cos(beta/2.0+delta/2.0));
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                 && fabs(b2)>EPS)       // a1=0, a2=0, b1!=0, b2!=0
-    {
-    beta=M_PI/2.0;
-    gamma=2.0*atan2(-b1,-b2);
-    delta=M_PI/2.0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                 && fabs(b2)>EPS)       // a1=0, a2!=0, b1!=0, b2!=0
-    {
-    beta  = M_PI/2.0 + atan(a2/b1);
-    delta = M_PI-beta;
-    gamma = 2.0*atan2(-b1/cos(beta/2.0-delta/2.0),-b2);
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                 && fabs(b2)>EPS)       // a1!=0, a2!=0, b1=0, b2!=0
-    {
-    beta  = M_PI/2.0 + atan(-b2/a1);
-    delta = -M_PI + beta;
-    gamma = 2.0*atan2(-a2, -b2/sin(beta/2.0+delta/2.0));
-    }
-    else;
-
-    // clang-format on
-
-    decomposition dec;
-    dec.alpha = alpha;
-    dec.beta = beta;
-    dec.delta = delta;
-    dec.gamma = gamma;
-    return dec;
+    return cachedDecomposition(DecompositionKernel::ZX, _op, &Operator::zxDecomposition);
 }
 
-decomposition Operator::zyDecomposition() { return zyDecomposition(_op); }
+decomposition Operator::zyDecomposition(UnitaryMatrix2x2 op) {
+    return DecompositionKernel::decompose(DecompositionKernel::ZY, op.a(), op.b(), op.c(), op.d());
+}
 
-decomposition Operator::xyDecomposition(UnitaryMatrix2x2 op) {
-    complex i = complex(0, 1);
-    double  alpha = 0;
-    double  beta = 0;
-    double  delta = 0;
-    double  gamma = 0;
-    complex a = op.a();
-    complex b = op.b();
-    complex c = op.c();
-    complex d = op.d();
-    double EPS = EPSILON;
-
-    // Author  : Швецкий Михаил Владимирович
-    // clang-format off
-
-    // *************************
-    // Вычисление X-Y-разложения
-    // ----------------------------
-    // Корректировка значения alpha
-    // ----------------------------
-    if (abs(d)>EPS)
-      if (abs(complex(1)+a/conj(d))<EPS)
-        alpha=M_PI/2.0;
-      else alpha=arg(a/conj(d))/2.0;
-    else if (abs(c)>EPS)
-      if (abs(complex(1)-b/conj(c))<EPS)
-        alpha=M_PI/2.0;
-      else alpha=arg(-b/conj(c))/2.0;
-    // ------------------------------
-    complex A, B;
-    double a1, a2, b1, b2;
-    A = (exp(-i*alpha)*(a+b) + exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-    B = (exp(-i*alpha)*(a+b) - exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-
-    a1 = real(A); a2 = imag(A); b1 = real(B); b2 = imag(B);
-    // ------------------------------
-    if (fabs(a1)<EPS && fabs(b2)<EPS)
-      if (fabs(b1)>EPS)                     // a1=0, a2=?, b1!=0, b2=0
-      {
-        delta=0;                            // delta - любое из R
-        beta=delta + 2.0*atan2(-a2,-b1);
-        gamma=M_PI;
-      }
-      else if (fabs(a2)>EPS)                // a1=0, a2!=0, b1=?, b2=0
-           {
-             delta= M_PI;                   // delta - любое из R
-             beta = delta-M_PI+2.0*atan2(-b1,a2);
-             gamma= M_PI;
-           }
-           else;
-    // ------------------------------
-    if (fabs(a2)<EPS && fabs(b1)<EPS)
-      if (fabs(a1)>EPS)                     // a1!=0, a2=0, b1=0, b2=?
-      {
-        delta=0;                            // delta - любое из R
-        beta=-delta + 2.0*atan2(-b2,a1);
-        gamma=0;
-      }
-      else if (fabs(b2)>EPS)                // a1=?, a2=0, b1=0, b2!=0
-           {
-             delta=0;                       // delta - любое из R
-             beta =-delta-M_PI+2.0*atan2(a1,b2);
-             gamma=0;
-           }
-           else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                     && fabs(b2)>EPS)       // a1=0, a2!=0, b1=0, b2!=0
-    {
-      beta=M_PI;
-      gamma=2.0*atan2(-a2,-b2);
-      delta=0;
-    }
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                     && fabs(b2)<EPS)       // a1!=0, a2!=0, b1=0, b2=0
-    {
-      beta=M_PI/2.0;
-      gamma=2.0*atan2(-a2,a1);
-      delta=-M_PI/2.0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                     && fabs(b2)<EPS)       // a1!=0, a2=0, b1!=0, b2=0
-    {
-      beta=0;
-      gamma=2.0*atan2(-b1,a1);
-      delta=0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1!=0, a2=0, b1!=0, b2!=0
-    {
-      beta=atan(-b2/a1);
-      gamma=2.0*atan2(-b1,-b2/sin(beta));
-      delta=beta;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1!=0, a2!=0, b1!=0, b2!=0
-    {
-      beta =atan(-b2/a1)+atan(a2/b1);
-      delta=atan(-b2/a1)-atan(a2/b1);
-      gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
-                      a1/cos(beta/2.0+delta/2.0));
+decomposition Operator::zyDecomposition() {
+    if (_gate != Gates::NONE) {
+        return Gates::getDecomposition(_gate, DecompositionKernel::ZY);
     }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                     && fabs(b2)<EPS)       // a1!=0, a2!=0, b1!=0, b2=0
-    {
-      beta =atan(-b2/a1)+atan(a2/b1);
-      delta=atan(-b2/a1)-atan(a2/b1);
-      gamma=2.0*atan2(-a2/sin(beta/2.0-delta/2.0),
-                      a1/cos(beta/2.0+delta/2.0));
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)<EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1=0, a2=0, b1!=0, b2!=0
-    {
-      beta=M_PI/2.0;
-      gamma=2.0*atan2(-b1,-b2);
-      delta=M_PI/2.0;
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)<EPS && fabs(a2)>EPS && fabs(b1)>EPS
-                     && fabs(b2)>EPS)       // a1=0, a2!=0, b1!=0, b2!=0
-    {
-      beta  = M_PI/2.0 + atan(a2/b1);
-      delta = M_PI-beta;
-      gamma = 2.0*atan2(-b1/cos(beta/2.0-delta/2.0),-b2);
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(a1)>EPS && fabs(a2)>EPS && fabs(b1)<EPS
-                     && fabs(b2)>EPS)       // a1!=0, a2!=0, b1=0, b2!=0
-    {
-      beta  = M_PI/2.0 + atan(-b2/a1);
-      delta = -M_PI + beta;
-      gamma = 2.0*atan2(-a2, -b2/sin(beta/2.0+delta/2.0));
-    }
-    else;
-
-    // clang-format on
-
-    decomposition dec;
-    dec.alpha = alpha;
-    dec.beta = beta;
-    dec.delta = delta;
-    dec.gamma = gamma;
-    return dec;
+    return cachedDecomposition(DecompositionKernel::ZY, _op, &Operator::zyDecomposition);
 }
 
-decomposition Operator::xyDecomposition() { return xyDecomposition(_op); }
+decomposition Operator::xyDecomposition(UnitaryMatrix2x2 op) {
+    return DecompositionKernel::decompose(DecompositionKernel::XY, op.a(), op.b(), op.c(), op.d());
+}
 
-decomposition Operator::zyxDecomposition(UnitaryMatrix2x2 op) {
-    complex i = complex(0, 1);
-    double  alpha = 0;
-    double  beta = 0;
-    double  delta = 0;
-    double  gamma = 0;
-    complex a = op.a();
-    complex b = op.b();
-    complex c = op.c();
-    complex d = op.d();
-    double EPS = EPSILON;
-
-    //  Author  : Швецкий Михаил Владимирович
-    // clang-format off
-
-    // ***************************
-    // Вычисление Z-Y-X-разложения
-    // ---------------------------
-    // Вычисление угла alpha
-    // ---------------------
-    if (abs(d)>EPS)
-    if (abs(complex(1)+a/conj(d))<EPS)
-    alpha=M_PI/2.0;
-    else alpha=arg(a/conj(d))/2.0;
-    else if (abs(c)>EPS)
-     if (abs(complex(1)-b/conj(c))<EPS)
-            alpha=M_PI/2.0;
-     else alpha=arg(-b/conj(c))/2.0;
-    // -----------------------------------
-    complex A,B;
-    A=(exp(-i*alpha)*(a+b) + exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-    B=(exp(-i*alpha)*(a+b) - exp(i*alpha)*(conj(c)+conj(d)))/2.0;
-    // ----------------------------------------------
-    double a1, a2, b1, b2;
-    a1=real(A); a2=imag(A); b1=real(B); b2=imag(B);
-    // -----------------------------------------------------
-    // Определение (полезных!) вспомогательных переменных...
-    // -----------------------------------------------------
-    double u1, u2, u3, u4;
-    u1=a1+b1; u2=a1-b1; u3=a2+b2; u4=a2-b2;
-    // ---------------------------------------------
-    if (fabs(u1)<EPS && fabs(u3)<EPS && fabs(u2)>EPS)
-    {
-    gamma=M_PI/2.0;
-    delta=0;       // delta - любое из R
-    if (-u4>0)
-    beta=delta + 2.0*acos(1.0/sqrt(2.0)*u2);     // (!)
-    else beta=delta - 2.0*acos(1.0/sqrt(2.0)*u2);  // (!)
-    }
-    else if (fabs(u1)<EPS && fabs(u3)<EPS && fabs(u4)>EPS)
-    {
-     gamma=M_PI/2.0;
-     delta=0;                // delta - любое из R
-     beta=delta - M_PI + 2.0*atan2(1.0/sqrt(2.0)*u2,
-                                   1.0/sqrt(2.0)*u4);
-    }
-    else;
-    // ----------------------------------------------
-    if (fabs(u4)<EPS && fabs(u2)<EPS && fabs(u1)>EPS)
-    {
-    gamma=-M_PI/2;                // или gamma=3*M_PI/2;
-    delta=0;                      // delta - любое из R
-    beta=-delta + 2.0*atan2(-1.0/sqrt(2.0)*u3,
-                         1.0/sqrt(2.0)*u1);
-    }
-    else if (fabs(u4)<EPS && fabs(u2)<EPS && fabs(u3)>EPS)
-    {
-     gamma=-M_PI/2.0;
-     delta=0;           // delta - любое из R
-     beta=-delta-M_PI+2.0*atan2(1.0/sqrt(2.0)*u1,
-                                1.0/sqrt(2.0)*u3);
-    }
-    else;
-    // -----------------------------
-    if (fabs(u1)<EPS && fabs(u4)>EPS
-               && fabs(u2)<EPS && fabs(u3)>EPS)
-    {
-    beta=M_PI;
-    delta=0;
-    gamma = 2.0*atan2((u3-u4)/2.0,-(u3+u4)/2.0);
-    }
-    else;
-    // -----------------------------
-    if (fabs(u1)>EPS && fabs(u4)>EPS
-               && fabs(u2)<EPS && fabs(u3)<EPS)
-    {
-    beta = M_PI/2.0;
-    delta=-M_PI/2.0;
-    gamma = 2.0*atan2(-(u1+u4)/2.0, (u1-u4)/2.0);
-    }
-    else;
-    // ---------------------------------------------
-    if (fabs(u1)>EPS && fabs(u4)<EPS && fabs(u2)>EPS
-               && fabs(u3)<EPS)
-    {
-    beta=0;
-    delta=0;
-    // ---------------------------------------------
-    // Решение системы тригонометрических уравнений:
-    //  sin(gamma/2)=(u2-u1)/2;
-    //  cos(gamma/2)=(u2+u1)/2;
-    // -----------------------------------------
-    gamma = 2.0*atan2((u2-u1)/2.0, (u2+u1)/2.0);
+decomposition Operator::xyDecomposition() {
+    if (_gate != Gates::NONE) {
+        return Gates::getDecomposition(_gate, DecompositionKernel::XY);
     }
-    else;
-    // ----------------------------------------------
-    if (fabs(u1)>EPS && fabs(u2)>EPS && fabs(u3)>EPS)
-                            // && fabs(u4)>EPS)
-    {
-    beta =-atan(u3/u1)-atan(u4/u2);
-    delta=-atan(u3/u1)+atan(u4/u2);
-    gamma = M_PI/2.0
-          + 2.0 * atan2(sqrt(2.0)/2.0 * u3/sin(beta/2+delta/2),
-                        sqrt(2.0)/2.0 * u2/cos(beta/2-delta/2));
-    }
-    else;
-    // -----------------------------
-    if (fabs(u1)<EPS && fabs(u4)<EPS
-               && fabs(u2)>EPS && fabs(u3)>EPS)
-    {
-    beta = M_PI/2.0;
-    delta= M_PI/2.0;
-    gamma= 2.0*atan2((u2+u3)/2.0, (u2-u3)/2.0);
-    }
-    else;
-    // -----------------------------
-    if (fabs(u1)<EPS && fabs(u4)>EPS
-               && fabs(u2)>EPS && fabs(u3)>EPS)
-    {
-    beta = M_PI/2.0 - atan(u4/u2);
-    delta= M_PI/2.0 + atan(u4/u2);
-    gamma=2.0*atan2(( u3 + u2/cos(beta/2.0-delta/2.0))/2.0,
-                (-u3 + u2/cos(beta/2.0-delta/2.0))/2.0);
-    }
-    else;
-    // -----------------------------
-    if (fabs(u1)>EPS && fabs(u4)>EPS
-               && fabs(u2)<EPS && fabs(u3)>EPS)
-    {
-    beta =M_PI/2.0 + atan(-u3/u1);
-    delta=-M_PI+beta;
-    gamma=2.0*atan2((-u1/cos(beta/2.0+delta/2.0)-u4)/2.0,
-                ( u1/cos(beta/2.0+delta/2.0)-u4)/2.0);
-    }
-    else;
-    // -----------------------------
-    if (fabs(u1)>EPS && fabs(u4)>EPS
-               && fabs(u2)>EPS && fabs(u3)<EPS)
-    {
-    beta =-atan(u4/u2);
-    delta=-beta;
-    gamma=2.0*atan2((-u4/sin(beta/2.0-delta/2.0)-u1)/2.0,
-                (-u4/sin(beta/2.0-delta/2.0)+u1)/2.0);
-    }
-    else;
-
-    // clang-format on
+    return cachedDecomposition(DecompositionKernel::XY, _op, &Operator::xyDecomposition);
+}
 
-    decomposition dec;
-    dec.alpha = alpha;
-    dec.beta = beta;
-    dec.delta = delta;
-    dec.gamma = gamma;
-    return dec;
+decomposition Operator::zyxDecomposition(UnitaryMatrix2x2 op) {
+    return DecompositionKernel::decompose(DecompositionKernel::ZYX, op.a(), op.b(), op.c(), op.d());
 }
 
-decomposition Operator::zyxDecomposition() { return zyxDecomposition(_op); }
+decomposition Operator::zyxDecomposition() {
+    if (_gate != Gates::NONE) {
+        return Gates::getDecomposition(_gate, DecompositionKernel::ZYX);
+    }
+    return cachedDecomposition(DecompositionKernel::ZYX, _op, &Operator::zyxDecomposition);
+}
 
 vectorangle Operator::vectorAngleDec(UnitaryMatrix2x2 op) {
-    decomposition zyDec = Operator::zyDecomposition(op);
-
-    zyDec.gamma = zyDec.gamma;
-    zyDec.beta = zyDec.beta;
-    zyDec.delta = zyDec.delta;
+    Vector3D axis;
+    double   angle = 0;
+    op.toQuaternion().getAxisAndAngle(&axis, &angle);
 
     vectorangle va;
-
-    va.angle = 2.0 * acos(cos(zyDec.gamma / 2.0) * cos(zyDec.beta / 2.0 + zyDec.delta / 2.0));
-    double sint = sin(va.angle / 2.0);
-    if (std::abs(sint) > EPSILON) {
-        va.x = sin(zyDec.gamma / 2.0) / sint * sin(zyDec.delta / 2.0 - zyDec.beta / 2.0);
-        va.y = sin(zyDec.gamma / 2.0) / sint * cos(zyDec.beta / 2.0 - zyDec.delta / 2.0);
-        va.z = cos(zyDec.gamma / 2.0) / sint * sin(zyDec.beta / 2.0 + zyDec.delta / 2.0);
-    } else {
-        va.x = 0;
-        va.y = 0;
-        va.z = 0;
-    }
-
+    va.x = axis.x();
+    va.y = axis.y();
+    va.z = axis.z();
+    va.angle = angle * M_PI / 180;
     return va;
 }
 
-vectorangle Operator::vectorAngleDec() { return vectorAngleDec(_op); }
+vectorangle Operator::vectorAngleDec() {
+    if (_gate != Gates::NONE) {
+        const double *axisAngle = Gates::TABLE[_gate].axisAngle;
+        vectorangle   va;
+        va.x = axisAngle[0];
+        va.y = axisAngle[1];
+        va.z = axisAngle[2];
+        va.angle = axisAngle[3];
+        return va;
+    }
+    return cachedVectorAngle(_op);
+}
 
 UnitaryMatrix2x2 Operator::genRandUnitaryMatrix(qint64 seed) {
     UnitaryMatrix2x2 op;
@@ -907,36 +300,62 @@ UnitaryMatrix2x2 Operator::genRandUnitaryMatrix(qint64 seed) {
 void Operator::setOperator(UnitaryMatrix2x2 op, QString opName) {
     _op = op;
     _opName = opName;
+    _gate = Gates::NONE;
 }
 
-QVector<Spike> Operator::applyOperator(Spike s) { return applyOperator(s, _op); }
+Operator Operator::fuse(const QVector<Operator> &ops) {
+    UnitaryMatrix2x2 product;
+    for (auto op : ops) {
+        product = op.getOperator() * product;
+    }
 
-QVector<Spike> Operator::applyVectorRotation(Spike s, UnitaryMatrix2x2 op) {
-    QVector<Spike> spike = {s};
-    if (Operator::getOperatorName(op) == "Id") {
-        return spike;
+    Operator    fused;
+    Gates::GATE g = Gates::findGate(product);
+    if (g != Gates::NONE) {
+        fused.setGate(g);
+    } else {
+        fused.setOperator(product);
     }
+    return fused;
+}
 
-    vectorangle va = vectorAngleDec(op);
+void Operator::setGate(Gates::GATE g) {
+    _op = UnitaryMatrix2x2::getGate(g);
+    _opName = Gates::TABLE[g].name;
+    _gate = g;
+}
 
-    QVector<Spike> vct = rotate(s, QVector3D(va.x, va.y, va.z), va.angle);
-    for (auto &e : vct) {
-        spike.append(e);
+Path Operator::applyOperator(Spike s) {
+    if (_gate == Gates::ID || (_gate == Gates::NONE && getOperatorName(_op) == "Id")) {
+        return Path(s);
+    }
+    return quaternionPath(s, _op.toQuaternion());
+}
+
+Path Operator::applyVectorRotation(Spike s, UnitaryMatrix2x2 op) {
+    if (Operator::getOperatorName(op) == "Id") {
+        return Path(s);
     }
 
-    std::reverse(spike.begin(), spike.end());
-    return spike;
+    vectorangle va = vectorAngleDec(op);
+    return rotate(s, Vector3D(va.x, va.y, va.z), va.angle);
 }
 
-QVector<Spike> Operator::applyVectorRotation(Spike s) { return applyVectorRotation(s, _op); }
+Path Operator::applyVectorRotation(Spike s) {
+    if (_gate == Gates::ID || (_gate == Gates::NONE && getOperatorName(_op) == "Id")) {
+        return Path(s);
+    }
+    vectorangle va = vectorAngleDec();
+    return rotate(s, Vector3D(va.x, va.y, va.z), va.angle);
+}
 
-void Operator::toId() { setOperator(UnitaryMatrix2x2::getId(), "Id"); }
-void Operator::toX() { setOperator(UnitaryMatrix2x2::getX(), "X"); }
-void Operator::toY() { setOperator(UnitaryMatrix2x2::getY(), "Y"); }
-void Operator::toZ() { setOperator(UnitaryMatrix2x2::getZ(), "Z"); }
-void Operator::toH() { setOperator(UnitaryMatrix2x2::getH(), "H"); }
-void Operator::toS() { setOperator(UnitaryMatrix2x2::getS(), "S"); }
-void Operator::toT() { setOperator(UnitaryMatrix2x2::getT(), "T"); }
+void Operator::toId() { setGate(Gates::ID); }
+void Operator::toX() { setGate(Gates::X); }
+void Operator::toY() { setGate(Gates::Y); }
+void Operator::toZ() { setGate(Gates::Z); }
+void Operator::toH() { setGate(Gates::H); }
+void Operator::toS() { setGate(Gates::S); }
+void Operator::toT() { setGate(Gates::T); }
 void Operator::toPhi(double gamma) {
     setOperator(UnitaryMatrix2x2::getPhi(gamma),
                 "Phi(" + QString::number(gamma * 180 / M_PI) + ")");
@@ -951,10 +370,10 @@ void Operator::toZrotate(double the) {
     setOperator(UnitaryMatrix2x2::getZrotate(the), "Rz(" + QString::number(the * 180 / M_PI) + ")");
 }
 
-QVector<Spike> Operator::applyZxDecomposition(Spike s) { return applyZxDecomposition(s, _op); }
-QVector<Spike> Operator::applyZyDecomposition(Spike s) { return applyZyDecomposition(s, _op); }
-QVector<Spike> Operator::applyXyDecomposition(Spike s) { return applyXyDecomposition(s, _op); }
-QVector<Spike> Operator::applyZyxDecomposition(Spike s) { return applyZyxDecomposition(s, _op); }
+Path Operator::applyZxDecomposition(Spike s) { return zxPath(s, zxDecomposition()); }
+Path Operator::applyZyDecomposition(Spike s) { return zyPath(s, zyDecomposition()); }
+Path Operator::applyXyDecomposition(Spike s) { return xyPath(s, xyDecomposition()); }
+Path Operator::applyZyxDecomposition(Spike s) { return zyxPath(s, zyxDecomposition()); }
 
 bool Operator::setOperatorByZxDecomposition(decomposition dec) {
     UnitaryMatrix2x2 matrixOp;
@@ -1109,23 +528,8 @@ QString Operator::getCurOperatorMatrixStr(UnitaryMatrix2x2 op) {
 QString Operator::getCurOperatorMatrixStr() { return getCurOperatorMatrixStr(_op); }
 
 QString Operator::getOperatorName(UnitaryMatrix2x2 op) {
-    QString opName = "U";
-    if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getId(), op, false)) {
-        opName = "Id";
-    } else if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getX(), op, false)) {
-        opName = "X";
-    } else if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getY(), op, false)) {
-        opName = "Y";
-    } else if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getZ(), op, false)) {
-        opName = "Z";
-    } else if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getH(), op, false)) {
-        opName = "H";
-    } else if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getS(), op, false)) {
-        opName = "S";
-    } else if (UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getT(), op, false)) {
-        opName = "T";
-    }
-    return opName;
+    Gates::GATE g = Gates::findGate(op);
+    return g == Gates::NONE ? QString("U") : QString(Gates::TABLE[g].name);
 }
 void Operator::toRandUnitaryMatrix() {
     UnitaryMatrix2x2 matrix = genRandUnitaryMatrix();
@@ -17,6 +17,8 @@
 #ifndef OPERATOR_HPP
 #define OPERATOR_HPP
 
+#include "DecompositionKernel.h"
+#include "Gates.h"
 #include "UnitaryMatrix2x2.h"
 #include "Vector.h"
 #include "src/utility.h"
@@ -29,22 +31,6 @@
 #include <cstdlib>
 #endif
 
-struct decomposition {
-    double alpha = 0; // rad
-    double beta = 0;  // rad
-    double delta = 0; // rad
-    double gamma = 0; // rad
-
-    void print(std::ostream &out) const {
-        out << "----------------------------------------------\n";
-        out << "alpha: " << alpha * 180 / M_PI << "\n";
-        out << "beta: " << beta * 180 / M_PI << "\n";
-        out << "delta: " << delta * 180 / M_PI << "\n";
-        out << "gamma: " << gamma * 180 / M_PI << "\n";
-        out << "----------------------------------------------\n";
-    }
-};
-
 struct vectorangle {
     double x = 0;
     double y = 0;
@@ -52,26 +38,34 @@ struct vectorangle {
     double angle = 0; // rad
 };
 
+// Counters of the decomposition cache of non-gate operators
+struct cachestatistics {
+    quint64 hits = 0;
+    quint64 misses = 0;
+    int     size = 0;
+    int     capacity = 0;
+};
+
 class Operator {
 public:
     Operator();
-    static QVector<Spike> rotate(Spike s, QVector3D v, double gamma);
-    static QVector<Spike> rXRotate(Spike s, double gamma);
-    static QVector<Spike> rYRotate(Spike s, double gamma);
-    static QVector<Spike> rZRotate(Spike s, double gamma);
-
-    static QVector<Spike> applyZxDecomposition(Spike s, UnitaryMatrix2x2 op);
-    QVector<Spike>        applyZxDecomposition(Spike s);
-    static QVector<Spike> applyZyDecomposition(Spike s, UnitaryMatrix2x2 op);
-    QVector<Spike>        applyZyDecomposition(Spike s);
-    static QVector<Spike> applyXyDecomposition(Spike s, UnitaryMatrix2x2 op);
-    QVector<Spike>        applyXyDecomposition(Spike s);
-    static QVector<Spike> applyZyxDecomposition(Spike s, UnitaryMatrix2x2 op);
-    QVector<Spike>        applyZyxDecomposition(Spike s);
-    static QVector<Spike> applyOperator(Spike s, UnitaryMatrix2x2 op);
-    QVector<Spike>        applyOperator(Spike s);
-    static QVector<Spike> applyVectorRotation(Spike s, UnitaryMatrix2x2 op);
-    QVector<Spike>        applyVectorRotation(Spike s);
+    static Path rotate(Spike s, Vector3D v, double gamma);
+    static Path rXRotate(Spike s, double gamma);
+    static Path rYRotate(Spike s, double gamma);
+    static Path rZRotate(Spike s, double gamma);
+
+    static Path applyZxDecomposition(Spike s, UnitaryMatrix2x2 op);
+    Path        applyZxDecomposition(Spike s);
+    static Path applyZyDecomposition(Spike s, UnitaryMatrix2x2 op);
+    Path        applyZyDecomposition(Spike s);
+    static Path applyXyDecomposition(Spike s, UnitaryMatrix2x2 op);
+    Path        applyXyDecomposition(Spike s);
+    static Path applyZyxDecomposition(Spike s, UnitaryMatrix2x2 op);
+    Path        applyZyxDecomposition(Spike s);
+    static Path applyOperator(Spike s, UnitaryMatrix2x2 op);
+    Path        applyOperator(Spike s);
+    static Path applyVectorRotation(Spike s, UnitaryMatrix2x2 op);
+    Path        applyVectorRotation(Spike s);
 
     static decomposition zxDecomposition(UnitaryMatrix2x2 op);
     decomposition        zxDecomposition();
@@ -97,8 +91,17 @@ public:
     bool setOperatorByVectorAngle(vectorangle va);
     void setOperator(UnitaryMatrix2x2 op, QString opName = "U");
 
+    // One operator with the effect of ops applied in order, ops.first() first
+    static Operator fuse(const QVector<Operator> &ops);
+
     static UnitaryMatrix2x2 genRandUnitaryMatrix(qint64 seed = 0);
 
+    // Decompositions and rotation axes asked of operator instances are kept in a bounded LRU
+    // cache keyed by the canonical matrix, so operators repeated in a circuit are decomposed once
+    static cachestatistics getCacheStatistics();
+    static void            setCacheCapacity(int capacity);
+    static void            clearCache();
+
     UnitaryMatrix2x2 getOperator() { return _op; }
 
     static QString getCurOperatorMatrixStr(UnitaryMatrix2x2 op);
@@ -127,6 +130,10 @@ public:
 private:
     UnitaryMatrix2x2 _op;
     QString          _opName;
+    // Set when the operator is a named gate, whose decompositions come from Gates::TABLE
+    Gates::GATE _gate = Gates::NONE;
+
+    void setGate(Gates::GATE g);
 };
 
 #endif // OPERATOR_HPP
@@ -0,0 +1,128 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Path.h"
+#include "src/utility.h"
+#include <cassert>
+#include <cmath>
+
+Path::Path() : first_() {}
+
+Path::Path(Spike s)
+    : first_(s), countOfFrames_(static_cast<int>(Utility::getDuration())), size_(1) {}
+
+void Path::addRotation(Vector3D axis, double angle) {
+    assert(size_ != 0 and countOfSegments_ < MAX_SEGMENTS);
+    Segment &segment = segments_[countOfSegments_];
+    segment.axis = axis;
+    segment.angle = angle * 180 / M_PI;
+    segment.first = last();
+    segment.last =
+        actOperator(Quaternion::fromAxisAndAngle(segment.axis, segment.angle), segment.first);
+    segment.isScaled = false;
+
+    ++countOfSegments_;
+    size_ = countOfFrames_ + 1;
+}
+
+void Path::addTurn(Spike to) {
+    assert(size_ != 0 and countOfSegments_ < MAX_SEGMENTS);
+    Segment &segment = segments_[countOfSegments_];
+    segment.first = last();
+    segment.last = to;
+    segment.isScaled = true;
+    segment.axis = Vector3D(0, 0, 1);
+    segment.angle = 0;
+
+    Vector3D from = segment.first.point.normalized();
+    Vector3D dir = to.point.normalized();
+    if (from.lengthSquared() > 0 and dir.lengthSquared() > 0) {
+        Vector3D axis = Vector3D::crossProduct(from, dir);
+        double   dot = Vector3D::dotProduct(from, dir);
+        // Opposite directions turn around any axis across them
+        if (axis.lengthSquared() < EPSILON * EPSILON and dot < 0) {
+            axis = Vector3D::crossProduct(Vector3D(1, 0, 0), from);
+            if (axis.lengthSquared() < EPSILON * EPSILON) {
+                axis = Vector3D::crossProduct(Vector3D(0, 1, 0), from);
+            }
+        }
+        if (axis.lengthSquared() > EPSILON * EPSILON) {
+            segment.axis = axis;
+            double sine = Vector3D::crossProduct(from, dir).length();
+            segment.angle = std::atan2(sine, dot) * 180 / M_PI;
+        }
+    }
+
+    ++countOfSegments_;
+    size_ = countOfFrames_ + 1;
+}
+
+void Path::setLast(Spike s) {
+    if (countOfSegments_ == 0) {
+        first_ = s;
+    } else {
+        segments_[countOfSegments_ - 1].last = s;
+    }
+}
+
+Spike Path::frame(int k) const {
+    assert(k >= 0 and k < size_);
+    return frameAt(k);
+}
+
+Spike Path::frameAt(double t) const {
+    assert(size_ != 0);
+    if (countOfSegments_ == 0 or t <= 0) {
+        return first_;
+    }
+    if (t >= size_ - 1) {
+        return last();
+    }
+
+    double u = t * countOfSegments_ / countOfFrames_;
+    int    i = static_cast<int>(u);
+    if (i >= countOfSegments_) {
+        return last();
+    }
+
+    const Segment &segment = segments_[i];
+    double         f = u - i;
+    if (f == 0) {
+        return segment.first;
+    }
+    Spike s = actOperator(Quaternion::fromAxisAndAngle(segment.axis, f * segment.angle),
+                          segment.first);
+    if (segment.isScaled) {
+        Vector3D dir = s.point.normalized();
+        if (dir.lengthSquared() == 0) {
+            dir = segment.last.point.normalized();
+        }
+        s.point = dir * ((1 - f) * segment.first.point.length() + f * segment.last.point.length());
+    }
+    return s;
+}
+
+Spike Path::last() const {
+    if (countOfSegments_ == 0) {
+        return first_;
+    }
+    return segments_[countOfSegments_ - 1].last;
+}
+
+Spike Path::actOperator(const Quaternion &q, Spike s) {
+    s.point = q.rotatedVector(s.point);
+    return s;
+}
@@ -0,0 +1,77 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef PATH_HPP
+#define PATH_HPP
+
+#include "Quaternion.h"
+#include "Vector3D.h"
+
+// State of a vector in the Bloch ball: on the sphere for a pure qubit, shorter for a qubit
+// entangled with others and at the centre when it is maximally mixed. The arrowhead is a
+// function of the point and is built when the vector is drawn.
+struct Spike {
+    Vector3D point;
+};
+
+// Animation path of a spike: up to MAX_SEGMENTS rotations played one after another, each one
+// for an equal share of the frames. Frames are evaluated on demand, so a path has a fixed size
+// whatever the speed and never allocates.
+class Path {
+public:
+    static const int MAX_SEGMENTS = 3;
+
+    // Path without frames
+    Path();
+    // Path of the single frame s; rotations added to it share Utility::getDuration() frames
+    explicit Path(Spike s);
+
+    // Rotation of the current end of the path around axis by angle (rad)
+    void addRotation(Vector3D axis, double angle);
+    // Turn of the current end of the path to the direction of to along a great circle, its length
+    // going linearly to that of to. Without a direction at one end the vector only grows or
+    // shrinks.
+    void addTurn(Spike to);
+    // Replaces the last frame of the path
+    void setLast(Spike s);
+
+    inline int  size() const { return size_; }
+    inline bool isEmpty() const { return size_ == 0; }
+    Spike       frame(int k) const;
+    // Frame at a fractional position t in [0, size() - 1], for playback driven by elapsed time
+    Spike frameAt(double t) const;
+    Spike last() const;
+
+    static Spike actOperator(const Quaternion &q, Spike s);
+
+private:
+    struct Segment {
+        Vector3D axis;
+        double   angle; // deg
+        Spike    first;
+        Spike    last;
+        // The length goes from that of first to that of last, as made by addTurn()
+        bool isScaled;
+    };
+
+    Spike   first_;
+    Segment segments_[MAX_SEGMENTS];
+    int     countOfSegments_ = 0;
+    int     countOfFrames_ = 0;
+    int     size_ = 0;
+};
+
+#endif // PATH_HPP
@@ -0,0 +1,108 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Quaternion.h"
+#include "src/utility.h"
+#include <cmath>
+
+double Quaternion::length() const { return std::sqrt(w_ * w_ + v_.lengthSquared()); }
+
+Quaternion Quaternion::normalized() const {
+    double len = w_ * w_ + v_.lengthSquared();
+    if (std::abs(len - 1.0) < EPSILON * EPSILON) {
+        return *this;
+    } else if (len > EPSILON * EPSILON) {
+        len = std::sqrt(len);
+        return Quaternion(w_ / len, v_ / len);
+    }
+    return Quaternion(0, 0, 0, 0);
+}
+
+Vector3D Quaternion::rotatedVector(const Vector3D &v) const {
+    return (*this * Quaternion(0, v) * conjugated()).vector();
+}
+
+void Quaternion::getAxisAndAngle(Vector3D *axis, double *angle) const {
+    Quaternion q = normalized();
+    double     len = q.v_.length();
+    if (len > EPSILON * EPSILON) {
+        *axis = q.v_ / len;
+        *angle = 2.0 * std::atan2(len, q.w_) * 180 / M_PI;
+    } else {
+        *axis = Vector3D();
+        *angle = 0;
+    }
+}
+
+double Quaternion::dotProduct(const Quaternion &q1, const Quaternion &q2) {
+    return q1.w_ * q2.w_ + Vector3D::dotProduct(q1.v_, q2.v_);
+}
+
+Quaternion Quaternion::fromAxisAndAngle(const Vector3D &axis, double angle) {
+    double a = angle / 2.0 * M_PI / 180;
+    return Quaternion(cos(a), axis.normalized() * sin(a)).normalized();
+}
+
+Quaternion Quaternion::rotationTo(const Vector3D &from, const Vector3D &to) {
+    // Based on Stan Melax's article in Game Programming Gems
+    const Vector3D v0(from.normalized());
+    const Vector3D v1(to.normalized());
+    double         d = Vector3D::dotProduct(v0, v1) + 1.0;
+
+    // if dest vector is close to the inverse of source vector, ANY axis of rotation is valid
+    if (std::abs(d) < EPSILON * EPSILON) {
+        Vector3D axis = Vector3D::crossProduct(Vector3D(1.0, 0.0, 0.0), v0);
+        if (axis.lengthSquared() < EPSILON * EPSILON) {
+            axis = Vector3D::crossProduct(Vector3D(0.0, 1.0, 0.0), v0);
+        }
+        // same as fromAxisAndAngle(axis, 180)
+        return Quaternion(0.0, axis.normalized());
+    }
+
+    d = std::sqrt(2.0 * d);
+    return Quaternion(d * 0.5, Vector3D::crossProduct(v0, v1) / d).normalized();
+}
+
+Quaternion Quaternion::slerp(const Quaternion &q1, const Quaternion &q2, double t) {
+    if (t <= 0.0) {
+        return q1;
+    } else if (t >= 1.0) {
+        return q2;
+    }
+
+    // Go the short way round; q and -q are the same rotation
+    Quaternion q2b = q2;
+    double     dot = dotProduct(q1, q2);
+    if (dot < 0.0) {
+        q2b = Quaternion(-q2.w_, -q2.v_);
+        dot = -dot;
+    }
+
+    double factor1 = 1.0 - t;
+    double factor2 = t;
+    if (1.0 - dot > EPSILON) {
+        double angle = std::acos(dot);
+        double sinOfAngle = std::sin(angle);
+        factor1 = std::sin((1.0 - t) * angle) / sinOfAngle;
+        factor2 = std::sin(t * angle) / sinOfAngle;
+    }
+    return Quaternion(factor1 * q1.w_ + factor2 * q2b.w_, factor1 * q1.v_ + factor2 * q2b.v_);
+}
+
+Quaternion operator*(const Quaternion &q1, const Quaternion &q2) {
+    return Quaternion(q1.w_ * q2.w_ - Vector3D::dotProduct(q1.v_, q2.v_),
+                      q1.w_ * q2.v_ + q2.w_ * q1.v_ + Vector3D::crossProduct(q1.v_, q2.v_));
+}
@@ -0,0 +1,54 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef QUATERNION_HPP
+#define QUATERNION_HPP
+
+#include "Vector3D.h"
+
+// Double precision quaternion. Mirrors the subset of the QQuaternion interface used by the
+// quantum core (angles in degrees, as in Qt).
+class Quaternion {
+public:
+    Quaternion() : w_(1), v_() {}
+    Quaternion(double scalar, double x, double y, double z) : w_(scalar), v_(x, y, z) {}
+    Quaternion(double scalar, const Vector3D &v) : w_(scalar), v_(v) {}
+
+    inline double          scalar() const { return w_; }
+    inline double          x() const { return v_.x(); }
+    inline double          y() const { return v_.y(); }
+    inline double          z() const { return v_.z(); }
+    inline const Vector3D &vector() const { return v_; }
+
+    double     length() const;
+    Quaternion normalized() const;
+    Quaternion conjugated() const { return Quaternion(w_, -v_); }
+    Vector3D   rotatedVector(const Vector3D &v) const;
+    void       getAxisAndAngle(Vector3D *axis, double *angle) const;
+
+    static double     dotProduct(const Quaternion &q1, const Quaternion &q2);
+    static Quaternion fromAxisAndAngle(const Vector3D &axis, double angle);
+    static Quaternion rotationTo(const Vector3D &from, const Vector3D &to);
+    static Quaternion slerp(const Quaternion &q1, const Quaternion &q2, double t);
+
+    friend Quaternion operator*(const Quaternion &q1, const Quaternion &q2);
+
+private:
+    double   w_;
+    Vector3D v_;
+};
+
+#endif // QUATERNION_HPP
@@ -0,0 +1,423 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Session.h"
+#include <QtEndian>
+#include <algorithm>
+#include <climits>
+#include <cstring>
+
+static_assert(sizeof(TraceVertex) == 6 * sizeof(float), "trace vertices are written as they are");
+
+namespace {
+const char MAGIC[8] = {'B', 'L', 'O', 'C', 'H', 'S', 'E', 'S'};
+const int  HEADER_SIZE = 16;
+const int  CHUNK_HEADER_SIZE = 16;
+const int  VECTOR_SIZE = 56;
+const int  TRACE_HEAD_SIZE = 16;
+
+constexpr quint32 tag(const char (&name)[5]) {
+    return quint32(quint8(name[0])) | quint32(quint8(name[1])) << 8 |
+           quint32(quint8(name[2])) << 16 | quint32(quint8(name[3])) << 24;
+}
+
+const quint32 VECTOR_TAG = tag("VECT");
+const quint32 TRACE_TAG = tag("TRAC");
+const quint32 QUEUE_TAG = tag("QUEU");
+const quint32 CIRCUIT_TAG = tag("CIRC");
+
+qint64 padded(qint64 size) { return (size + 7) / 8 * 8; }
+
+void putU32(QByteArray *out, quint32 v) {
+    uchar bytes[4];
+    qToLittleEndian(v, bytes);
+    out->append(reinterpret_cast<const char *>(bytes), 4);
+}
+
+void putU64(QByteArray *out, quint64 v) {
+    uchar bytes[8];
+    qToLittleEndian(v, bytes);
+    out->append(reinterpret_cast<const char *>(bytes), 8);
+}
+
+void putF32(QByteArray *out, float f) {
+    quint32 v;
+    std::memcpy(&v, &f, 4);
+    putU32(out, v);
+}
+
+void putF64(QByteArray *out, double d) {
+    quint64 v;
+    std::memcpy(&v, &d, 8);
+    putU64(out, v);
+}
+
+void putRgb(QByteArray *out, rgb color) {
+    putF32(out, color.red);
+    putF32(out, color.green);
+    putF32(out, color.blue);
+}
+
+void putString(QByteArray *out, const QString &str) {
+    QByteArray utf8 = str.toUtf8();
+    putU32(out, static_cast<quint32>(utf8.size()));
+    out->append(utf8);
+}
+
+quint32 getU32(const uchar *p) { return qFromLittleEndian<quint32>(p); }
+
+quint64 getU64(const uchar *p) { return qFromLittleEndian<quint64>(p); }
+
+float getF32(const uchar *p) {
+    quint32 v = getU32(p);
+    float   f;
+    std::memcpy(&f, &v, 4);
+    return f;
+}
+
+double getF64(const uchar *p) {
+    quint64 v = getU64(p);
+    double  d;
+    std::memcpy(&d, &v, 8);
+    return d;
+}
+
+rgb getRgb(const uchar *p) {
+    rgb color = {getF32(p), getF32(p + 4), getF32(p + 8)};
+    return color;
+}
+
+// Name at p of at most size bytes with its length; false if it does not fit
+bool getString(const uchar *p, qint64 size, QString *str, qint64 *used) {
+    if (size < 4 or getU32(p) > size - 4) {
+        return false;
+    }
+    *used = 4 + getU32(p);
+    *str = QString::fromUtf8(reinterpret_cast<const char *>(p + 4), static_cast<int>(*used - 4));
+    return true;
+}
+} // namespace
+
+SessionWriter::SessionWriter(const QString &fileName) : file_(fileName) {
+    if (not file_.open(QIODevice::WriteOnly)) {
+        return;
+    }
+    QByteArray header(MAGIC, sizeof(MAGIC));
+    putU32(&header, Session::VERSION);
+    putU32(&header, 0);
+    if (file_.write(header) != header.size()) {
+        file_.cancelWriting();
+    }
+}
+
+bool SessionWriter::commit() { return isOpen() and file_.commit(); }
+
+bool SessionWriter::writeChunkHeader(quint32 tag, qint64 size) {
+    QByteArray header;
+    putU32(&header, tag);
+    putU32(&header, 0);
+    putU64(&header, static_cast<quint64>(size));
+    return file_.write(header) == header.size();
+}
+
+bool SessionWriter::writeBlock(const void *data, qint64 countOfWords, int wordSize) {
+    qint64 size = countOfWords * wordSize;
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    return file_.write(static_cast<const char *>(data), size) == size;
+#else
+    // Swapped in pieces of 64 KiB
+    const char *bytes = static_cast<const char *>(data);
+    QByteArray  words;
+    for (qint64 offset = 0; offset < size; offset += words.size()) {
+        int count = static_cast<int>(qMin<qint64>(1 << 16, size - offset));
+        words = QByteArray(bytes + offset, count);
+        for (int k = 0; k < words.size(); k += wordSize) {
+            std::reverse(words.data() + k, words.data() + k + wordSize);
+        }
+        if (file_.write(words) != words.size()) {
+            return false;
+        }
+    }
+    return true;
+#endif
+}
+
+bool SessionWriter::writePadding(qint64 size) {
+    QByteArray zeros(static_cast<int>(padded(size) - size), '\0');
+    return file_.write(zeros) == zeros.size();
+}
+
+bool SessionWriter::writeChunk(quint32 tag, const QByteArray &payload) {
+    return writeChunkHeader(tag, payload.size()) and
+           writeBlock(payload.constData(), payload.size(), 1) and writePadding(payload.size());
+}
+
+bool SessionWriter::writeVector(const Vector &v) {
+    QByteArray payload;
+    Vector3D   point = v.getSpike().point;
+    putF64(&payload, point.x());
+    putF64(&payload, point.y());
+    putF64(&payload, point.z());
+    putRgb(&payload, v.getSelfColor());
+    putRgb(&payload, v.getTraceColor());
+    putU32(&payload, v.isTraceEnabled() ? 1 : 0);
+    putString(&payload, v.getName());
+    if (not isOpen() or not writeChunk(VECTOR_TAG, payload)) {
+        return false;
+    }
+    if (v.getTrace().isEmpty()) {
+        return true;
+    }
+
+    // The vertices go from the trace to the file without a copy
+    tracearrays arrays = v.getTrace().arrays();
+    QByteArray  head;
+    putU32(&head, static_cast<quint32>(arrays.countOfVertices));
+    putU32(&head, static_cast<quint32>(arrays.countOfRuns));
+    putF64(&head, arrays.length);
+    qint64 size = head.size() + qint64(arrays.countOfVertices) * qint64(sizeof(TraceVertex)) +
+                  qint64(arrays.countOfRuns) * 4;
+    return writeChunkHeader(TRACE_TAG, size) and writeBlock(head.constData(), head.size(), 1) and
+           writeBlock(arrays.vertices, qint64(arrays.countOfVertices) * 6, 4) and
+           writeBlock(arrays.runs, arrays.countOfRuns, 4) and writePadding(size);
+}
+
+bool SessionWriter::writeQueue(const QVector<Operator> &queue) {
+    QByteArray payload;
+    putU32(&payload, static_cast<quint32>(queue.size()));
+    putU32(&payload, 0);
+    for (Operator op : queue) {
+        complex entries[4] = {op.a(), op.b(), op.c(), op.d()};
+        for (complex e : entries) {
+            putF64(&payload, e.real());
+            putF64(&payload, e.imag());
+        }
+    }
+    for (Operator op : queue) {
+        putString(&payload, op.getOperatorName());
+    }
+    return isOpen() and writeChunk(QUEUE_TAG, payload);
+}
+
+bool SessionWriter::writeCircuit(const CircuitModel &circuit) {
+    qint64     cells = qint64(circuit.countOfQubits()) * circuit.countOfSteps();
+    QByteArray head;
+    putU32(&head, static_cast<quint32>(circuit.countOfQubits()));
+    putU32(&head, static_cast<quint32>(circuit.countOfSteps()));
+
+    QVector<double> angles;
+    angles.reserve(static_cast<int>(cells));
+    for (int s = 0; s < circuit.countOfSteps(); ++s) {
+        for (int q = 0; q < circuit.countOfQubits(); ++q) {
+            circuitcell c = circuit.cell(q, s);
+            head.append(static_cast<char>(c.gate));
+            angles.append(c.angle);
+        }
+    }
+    head.append(QByteArray(static_cast<int>(padded(head.size()) - head.size()), '\0'));
+
+    qint64 size = head.size() + cells * 8;
+    return isOpen() and writeChunkHeader(CIRCUIT_TAG, size) and
+           writeBlock(head.constData(), head.size(), 1) and
+           writeBlock(angles.constData(), cells, 8) and writePadding(size);
+}
+
+bool SessionReader::open(const QString &fileName) {
+    clear();
+    file_.setFileName(fileName);
+    if (not file_.open(QIODevice::ReadOnly)) {
+        return fail(file_.errorString());
+    }
+
+    qint64       size = file_.size();
+    const uchar *data = size >= HEADER_SIZE ? file_.map(0, size) : nullptr;
+    if (data == nullptr or std::memcmp(data, MAGIC, sizeof(MAGIC)) != 0) {
+        return fail("not a session file");
+    }
+    if (getU32(data + 8) > Session::VERSION) {
+        return fail(QString("session version %1 is newer than this program").arg(getU32(data + 8)));
+    }
+
+    for (qint64 offset = HEADER_SIZE; offset < size;) {
+        if (size - offset < CHUNK_HEADER_SIZE or
+            getU64(data + offset + 8) > quint64(size - offset - CHUNK_HEADER_SIZE)) {
+            return fail("truncated session file");
+        }
+        quint32      chunkTag = getU32(data + offset);
+        qint64       chunkSize = static_cast<qint64>(getU64(data + offset + 8));
+        const uchar *chunk = data + offset + CHUNK_HEADER_SIZE;
+
+        bool ok = true;
+        if (chunkTag == VECTOR_TAG) {
+            ok = readVector(chunk, chunkSize);
+        } else if (chunkTag == TRACE_TAG) {
+            ok = readTrace(chunk, chunkSize);
+        } else if (chunkTag == QUEUE_TAG) {
+            ok = readQueue(chunk, chunkSize);
+        } else if (chunkTag == CIRCUIT_TAG) {
+            ok = readCircuit(chunk, chunkSize);
+        }
+        if (not ok) {
+            return fail(QString("malformed chunk at byte %1").arg(offset));
+        }
+        offset += CHUNK_HEADER_SIZE + qMin(padded(chunkSize), size - offset - CHUNK_HEADER_SIZE);
+    }
+    return true;
+}
+
+bool SessionReader::fail(const QString &error) {
+    clear();
+    error_ = error;
+    return false;
+}
+
+void SessionReader::clear() {
+    error_.clear();
+    vectors_.clear();
+    queue_.clear();
+    circuit_ = CircuitModel(0, 0);
+    hasCircuit_ = false;
+    file_.close();
+    swapped_.clear();
+}
+
+const char *SessionReader::block(const uchar *data, qint64 countOfWords, int wordSize) {
+#if Q_BYTE_ORDER == Q_LITTLE_ENDIAN
+    Q_UNUSED(countOfWords);
+    Q_UNUSED(wordSize);
+    return reinterpret_cast<const char *>(data);
+#else
+    QByteArray words(reinterpret_cast<const char *>(data),
+                     static_cast<int>(countOfWords * wordSize));
+    for (int k = 0; k < words.size(); k += wordSize) {
+        std::reverse(words.data() + k, words.data() + k + wordSize);
+    }
+    swapped_.append(words);
+    return swapped_.last().constData();
+#endif
+}
+
+bool SessionReader::readVector(const uchar *data, qint64 size) {
+    sessionvector v;
+    qint64        used = 0;
+    if (size < VECTOR_SIZE or not getString(data + VECTOR_SIZE - 4, size - VECTOR_SIZE + 4,
+                                             &v.name, &used)) {
+        return false;
+    }
+    v.point = Vector3D(getF64(data), getF64(data + 8), getF64(data + 16));
+    v.selfColor = getRgb(data + 24);
+    v.traceColor = getRgb(data + 36);
+    v.traceEnabled = (getU32(data + 48) & 1) != 0;
+    v.trace = {nullptr, 0, nullptr, 0, 0.};
+    vectors_.append(v);
+    return true;
+}
+
+bool SessionReader::readTrace(const uchar *data, qint64 size) {
+    if (vectors_.isEmpty() or size < TRACE_HEAD_SIZE) {
+        return false;
+    }
+    qint64 countOfVertices = getU32(data);
+    qint64 countOfRuns = getU32(data + 4);
+    if (TRACE_HEAD_SIZE + countOfVertices * qint64(sizeof(TraceVertex)) + countOfRuns * 4 > size or
+        countOfRuns > countOfVertices) {
+        return false;
+    }
+
+    tracearrays &trace = vectors_.last().trace;
+    trace.countOfVertices = static_cast<int>(countOfVertices);
+    trace.countOfRuns = static_cast<int>(countOfRuns);
+    trace.length = getF64(data + 8);
+    trace.vertices = reinterpret_cast<const TraceVertex *>(
+        block(data + TRACE_HEAD_SIZE, countOfVertices * 6, 4));
+    trace.runs = reinterpret_cast<const qint32 *>(
+        block(data + TRACE_HEAD_SIZE + countOfVertices * sizeof(TraceVertex), countOfRuns, 4));
+
+    // Runs index the vertices when drawn, so they must start at 0 and increase
+    for (int k = 0; k < trace.countOfRuns; ++k) {
+        if (trace.runs[k] >= trace.countOfVertices or
+            (k == 0 ? trace.runs[k] != 0 : trace.runs[k] <= trace.runs[k - 1])) {
+            return false;
+        }
+    }
+    return trace.countOfVertices == 0 or trace.countOfRuns > 0;
+}
+
+bool SessionReader::readQueue(const uchar *data, qint64 size) {
+    qint64 count = size >= 8 ? getU32(data) : 0;
+    qint64 offset = 8 + count * 64;
+    if (size < 8 or offset > size) {
+        return false;
+    }
+
+    QVector<Operator> queue;
+    for (qint64 k = 0; k < count; ++k) {
+        const uchar *p = data + 8 + k * 64;
+        matrix2x2    m;
+        m.a = complex(getF64(p), getF64(p + 8));
+        m.b = complex(getF64(p + 16), getF64(p + 24));
+        m.c = complex(getF64(p + 32), getF64(p + 40));
+        m.d = complex(getF64(p + 48), getF64(p + 56));
+
+        UnitaryMatrix2x2 u;
+        QString          name;
+        qint64           used = 0;
+        if (not u.updateMatrix(m) or not getString(data + offset, size - offset, &name, &used)) {
+            return false;
+        }
+        offset += used;
+
+        Operator op;
+        op.setOperator(u, name);
+        queue.append(op);
+    }
+    queue_ = queue;
+    return true;
+}
+
+bool SessionReader::readCircuit(const uchar *data, qint64 size) {
+    if (size < 8) {
+        return false;
+    }
+    qint64 qubits = getU32(data);
+    qint64 steps = getU32(data + 4);
+    // Every cell takes 9 bytes, which also keeps the product below from overflowing
+    if (qubits > INT_MAX or steps > INT_MAX or (qubits == 0 and steps > 0) or
+        (qubits > 0 and steps > size / 9 / qubits)) {
+        return false;
+    }
+    qint64 cells = qubits * steps;
+    qint64 anglesOffset = padded(8 + cells);
+    if (anglesOffset + cells * 8 > size) {
+        return false;
+    }
+
+    const double *angles = reinterpret_cast<const double *>(block(data + anglesOffset, cells, 8));
+    CircuitModel  circuit(static_cast<int>(qubits), static_cast<int>(steps));
+    for (int s = 0; s < steps; ++s) {
+        for (int q = 0; q < qubits; ++q) {
+            qint64      k = qint64(s) * qubits + q;
+            circuitcell c = {data[8 + k], angles[k]};
+            if (c.gate >= CircuitModel::COUNT) {
+                return false;
+            }
+            circuit.setCell(q, s, c);
+        }
+    }
+    circuit_ = circuit;
+    hasCircuit_ = true;
+    return true;
+}
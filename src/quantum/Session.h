@@ -0,0 +1,118 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef SESSION_HPP
+#define SESSION_HPP
+
+#include "CircuitModel.h"
+#include "Operator.h"
+#include "Trace.h"
+#include "Vector.h"
+#include <QByteArray>
+#include <QFile>
+#include <QSaveFile>
+#include <QVector>
+
+// Session files keep the vectors with their traces, the operator queue and the circuit. They are
+// little-endian: a header, "BLOCHSES" and the u32 version, then chunks of a u32 tag, a u32 zero
+// and the u64 size of the payload, which is padded with zeros to a multiple of 8 bytes.
+//
+//     VECT  f64 x y z, f32 rgb of the vector and of its trace, u32 flags (1: trace shown),
+//           u32 size and the UTF-8 name
+//     TRAC  trace of the last vector: u32 vertices, u32 runs, f64 length, then the vertices as
+//           f32 x y z r g b and the i32 first vertex of each run
+//     QUEU  u32 operators, u32 zero, f64 re and im of a b c d of each, then each u32 size and
+//           the UTF-8 name
+//     CIRC  u32 qubits, u32 steps, the u8 gate of each cell step after step, padded to 8 bytes,
+//           then the f64 angle of each cell
+//
+// Chunks are appended as they are written, so a file is complete after each one. Readers skip
+// tags they do not know.
+namespace Session {
+const quint32 VERSION = 1;
+} // namespace Session
+
+// Vector of a session file; the trace arrays point into the mapped file
+struct sessionvector {
+    QString     name;
+    Vector3D    point;
+    rgb         selfColor;
+    rgb         traceColor;
+    bool        traceEnabled;
+    tracearrays trace;
+};
+
+class SessionWriter {
+public:
+    // Writes the header to a temporary file; the target is untouched until commit()
+    explicit SessionWriter(const QString &fileName);
+
+    bool    isOpen() const { return file_.isOpen(); }
+    QString errorString() const { return file_.errorString(); }
+
+    bool writeVector(const Vector &v);
+    bool writeQueue(const QVector<Operator> &queue);
+    bool writeCircuit(const CircuitModel &circuit);
+    // Replaces the target with everything written; false if any write failed
+    bool commit();
+
+private:
+    QSaveFile file_;
+
+    bool writeChunkHeader(quint32 tag, qint64 size);
+    // Words in host order, written little-endian
+    bool writeBlock(const void *data, qint64 countOfWords, int wordSize);
+    bool writePadding(qint64 size);
+    bool writeChunk(quint32 tag, const QByteArray &payload);
+};
+
+// Reads a session by mapping the file, so the traces are not copied or parsed however long
+class SessionReader {
+public:
+    SessionReader() = default;
+    SessionReader(const SessionReader &) = delete;
+    SessionReader &operator=(const SessionReader &) = delete;
+
+    // False with the reason in errorString() if the file is not a session this version can read
+    bool    open(const QString &fileName);
+    QString errorString() const { return error_; }
+
+    // Valid while the reader stays open
+    const QVector<sessionvector> &getVectors() const { return vectors_; }
+    const QVector<Operator>      &getQueue() const { return queue_; }
+    const CircuitModel           &getCircuit() const { return circuit_; }
+    bool                          hasCircuit() const { return hasCircuit_; }
+
+private:
+    QFile                  file_;
+    QString                error_;
+    QVector<sessionvector> vectors_;
+    QVector<Operator>      queue_;
+    CircuitModel           circuit_ = CircuitModel(0, 0);
+    bool                   hasCircuit_ = false;
+    // Blocks in host order on big-endian hosts; little-endian ones use the mapped file as is
+    QVector<QByteArray> swapped_;
+
+    bool        fail(const QString &error);
+    void        clear();
+    const char *block(const uchar *data, qint64 countOfWords, int wordSize);
+    bool        readVector(const uchar *data, qint64 size);
+    bool        readTrace(const uchar *data, qint64 size);
+    bool        readQueue(const uchar *data, qint64 size);
+    bool        readCircuit(const uchar *data, qint64 size);
+};
+
+#endif // SESSION_HPP
@@ -0,0 +1,209 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "StateVector.h"
+#include "Qubit.h"
+#include <cassert>
+#include <thread>
+
+namespace {
+// Fewest amplitude pairs worth a worker thread of their own
+const qint64 PAIRS_PER_THREAD = qint64(1) << 14;
+
+int threadCount = qMax(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+int countOfBlocks(qint64 count) {
+    return static_cast<int>(qBound<qint64>(1, count / PAIRS_PER_THREAD, threadCount));
+}
+
+// Calls f(begin, end, block) for each of blocks equal parts of [0, count), all but the first in
+// worker threads
+template <typename F> void forBlocks(qint64 count, int blocks, F f) {
+    qint64 step = (count + blocks - 1) / blocks;
+    if (blocks == 1) {
+        f(0, count, 0);
+        return;
+    }
+
+    std::vector<std::thread> workers;
+    for (int t = 1; t < blocks; ++t) {
+        workers.emplace_back(f, qMin(count, t * step), qMin(count, (t + 1) * step), t);
+    }
+    f(0, step, 0);
+    for (auto &worker : workers) {
+        worker.join();
+    }
+}
+
+// Calls f(lo, hi, n) for the runs of pairs begin..end of qubit with the given stride: lo[j] and
+// hi[j] for j < n differ in the qubit's bit only
+template <typename T, typename F>
+void forPairs(T *data, qint64 stride, qint64 begin, qint64 end, F f) {
+    qint64 mask = stride - 1;
+    for (qint64 p = begin; p < end;) {
+        qint64 offset = p & mask;
+        qint64 run = qMin(end - p, stride - offset);
+        T     *lo = data + ((p - offset) << 1) + offset;
+        f(lo, lo + stride, run);
+        p += run;
+    }
+}
+} // namespace
+
+StateVector::StateVector(int countOfQubits)
+    : countOfQubits_(countOfQubits), amplitudes_(size_t(1) << countOfQubits) {
+    assert(countOfQubits >= 1 and countOfQubits <= MAX_QUBITS);
+    amplitudes_[0] = 1;
+}
+
+StateVector StateVector::fromBlochVectors(const QVector<Vector3D> &vectors) {
+    StateVector state(vectors.size());
+    qint64      filled = 1;
+    for (int k = 0; k < vectors.size(); ++k) {
+        Qubit q(vectors[k].x(), vectors[k].y(), vectors[k].z());
+        for (qint64 i = 0; i < filled; ++i) {
+            state.amplitudes_[i + filled] = state.amplitudes_[i] * q.b();
+            state.amplitudes_[i] *= q.a();
+        }
+        filled <<= 1;
+    }
+    return state;
+}
+
+double StateVector::norm() const {
+    double sum = 0;
+    for (const complex &a : amplitudes_) {
+        sum += std::norm(a);
+    }
+    return std::sqrt(sum);
+}
+
+void StateVector::reset() {
+    std::fill(amplitudes_.begin(), amplitudes_.end(), complex(0));
+    amplitudes_[0] = 1;
+}
+
+void StateVector::apply(int qubit, const UnitaryMatrix2x2 &op) {
+    assert(qubit >= 0 and qubit < countOfQubits_);
+    complex  a = op.a();
+    complex  b = op.b();
+    complex  c = op.c();
+    complex  d = op.d();
+    complex *data = amplitudes_.data();
+    qint64   stride = qint64(1) << qubit;
+    qint64   pairs = size() / 2;
+
+    forBlocks(pairs, countOfBlocks(pairs), [=](qint64 begin, qint64 end, int) {
+        forPairs(data, stride, begin, end, [=](complex *lo, complex *hi, qint64 n) {
+            for (qint64 j = 0; j < n; ++j) {
+                complex x0 = lo[j];
+                complex x1 = hi[j];
+                lo[j] = a * x0 + b * x1;
+                hi[j] = c * x0 + d * x1;
+            }
+        });
+    });
+}
+
+void StateVector::applyControlled(int control, int qubit, const UnitaryMatrix2x2 &op) {
+    assert(control >= 0 and control < countOfQubits_ and control != qubit);
+    applyWhere(qint64(1) << control, qubit, op);
+}
+
+void StateVector::applyWhere(qint64 mask, int qubit, const UnitaryMatrix2x2 &op) {
+    assert(qubit >= 0 and qubit < countOfQubits_);
+    complex  a = op.a();
+    complex  b = op.b();
+    complex  c = op.c();
+    complex  d = op.d();
+    complex *data = amplitudes_.data();
+    qint64   stride = qint64(1) << qubit;
+    qint64   pairs = size() / 2;
+
+    forBlocks(pairs, countOfBlocks(pairs), [=](qint64 begin, qint64 end, int) {
+        forPairs(data, stride, begin, end, [=](complex *lo, complex *hi, qint64 n) {
+            qint64 first = lo - data;
+            for (qint64 j = 0; j < n; ++j) {
+                if (((first + j) & mask) == mask) {
+                    complex x0 = lo[j];
+                    complex x1 = hi[j];
+                    lo[j] = a * x0 + b * x1;
+                    hi[j] = c * x0 + d * x1;
+                }
+            }
+        });
+    });
+}
+
+void StateVector::applyStep(const QVector<UnitaryMatrix2x2> &ops, const QVector<int> &controls) {
+    assert(ops.size() <= countOfQubits_);
+    qint64 mask = 0;
+    for (int control : controls) {
+        assert(control >= 0 and control < countOfQubits_);
+        mask |= qint64(1) << control;
+    }
+    for (int k = 0; k < ops.size(); ++k) {
+        // The identity is the common case in a circuit grid and costs a pass over the state
+        const UnitaryMatrix2x2 &op = ops[k];
+        if (op.a() == 1.0 and op.b() == 0.0 and op.c() == 0.0 and op.d() == 1.0) {
+            continue;
+        }
+        if (mask == 0) {
+            apply(k, op);
+        } else {
+            applyWhere(mask, k, op);
+        }
+    }
+}
+
+Vector3D StateVector::blochVector(int qubit) const {
+    assert(qubit >= 0 and qubit < countOfQubits_);
+    // Reduced density matrix ((p0, r*), (r, p1)) summed per block
+    const complex       *data = amplitudes_.data();
+    qint64               stride = qint64(1) << qubit;
+    qint64               pairs = size() / 2;
+    int                  blocks = countOfBlocks(pairs);
+    std::vector<double>  p0(blocks);
+    std::vector<double>  p1(blocks);
+    std::vector<complex> r(blocks);
+
+    forBlocks(pairs, blocks, [&](qint64 begin, qint64 end, int block) {
+        double  sum0 = 0;
+        double  sum1 = 0;
+        complex sum01 = 0;
+        forPairs(data, stride, begin, end, [&](const complex *lo, const complex *hi, qint64 n) {
+            for (qint64 j = 0; j < n; ++j) {
+                sum0 += std::norm(lo[j]);
+                sum1 += std::norm(hi[j]);
+                sum01 += std::conj(lo[j]) * hi[j];
+            }
+        });
+        p0[block] = sum0;
+        p1[block] = sum1;
+        r[block] = sum01;
+    });
+
+    double  z = 0;
+    complex xy = 0;
+    for (int t = 0; t < blocks; ++t) {
+        z += p0[t] - p1[t];
+        xy += r[t];
+    }
+    return Vector3D(2 * xy.real(), 2 * xy.imag(), z);
+}
+
+int  StateVector::getThreadCount() { return threadCount; }
+void StateVector::setThreadCount(int count) { threadCount = qMax(1, count); }
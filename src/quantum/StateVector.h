@@ -0,0 +1,65 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef STATEVECTOR_HPP
+#define STATEVECTOR_HPP
+
+#include "UnitaryMatrix2x2.h"
+#include "Vector3D.h"
+#include <QVector>
+#include <vector>
+
+// Pure state of n qubits as 2^n amplitudes in one contiguous array; qubit k is bit k of the
+// amplitude index. Gates act in place, and on large states the amplitude pairs are split into
+// blocks handled by worker threads.
+class StateVector {
+public:
+    static const int MAX_QUBITS = 30;
+
+    explicit StateVector(int countOfQubits = 1);
+
+    // Product state of qubits at the given Bloch vectors
+    static StateVector fromBlochVectors(const QVector<Vector3D> &vectors);
+
+    int            countOfQubits() const { return countOfQubits_; }
+    qint64         size() const { return static_cast<qint64>(amplitudes_.size()); }
+    complex        amplitude(qint64 index) const { return amplitudes_[index]; }
+    const complex *amplitudes() const { return amplitudes_.data(); }
+    double         norm() const;
+
+    void reset();
+    void apply(int qubit, const UnitaryMatrix2x2 &op);
+    // op on qubit where the control qubit is 1
+    void applyControlled(int control, int qubit, const UnitaryMatrix2x2 &op);
+    // One circuit step: ops[k] acts on qubit k where all the control qubits are 1
+    void applyStep(const QVector<UnitaryMatrix2x2> &ops, const QVector<int> &controls = {});
+
+    // Bloch vector of the reduced state of the qubit; shorter than 1 when it is entangled
+    Vector3D blochVector(int qubit) const;
+
+    // Worker threads for large states, the hardware concurrency by default
+    static int  getThreadCount();
+    static void setThreadCount(int count);
+
+private:
+    int                  countOfQubits_;
+    std::vector<complex> amplitudes_;
+
+    // op on qubit where all the bits of mask are 1
+    void applyWhere(qint64 mask, int qubit, const UnitaryMatrix2x2 &op);
+};
+
+#endif // STATEVECTOR_HPP
@@ -0,0 +1,158 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Trace.h"
+#include "src/utility.h"
+#include <algorithm>
+
+namespace {
+TracePolicy policy;
+// Points merged into one segment before a new vertex is forced, which bounds the cost of a merge
+const int MAX_MERGED = 64;
+
+TraceVertex vertex(const Vector3D &v, rgb color) {
+    TraceVertex tv;
+    tv.x = static_cast<float>(v.x());
+    tv.y = static_cast<float>(v.y());
+    tv.z = static_cast<float>(v.z());
+    tv.color = color;
+    return tv;
+}
+
+Vector3D point(const TraceVertex &tv) { return Vector3D(tv.x, tv.y, tv.z); }
+
+bool isSamePoint(const TraceVertex &tv, const Vector3D &v) {
+    return std::abs(tv.x - v.x()) < EPSILON and std::abs(tv.y - v.y()) < EPSILON and
+           std::abs(tv.z - v.z()) < EPSILON;
+}
+
+bool isSameColor(rgb c1, rgb c2) {
+    return c1.red == c2.red and c1.green == c2.green and c1.blue == c2.blue;
+}
+
+double distanceToSegment(const Vector3D &p, const Vector3D &a, const Vector3D &b) {
+    Vector3D ab = b - a;
+    double   t = ab.lengthSquared() > 0 ? Vector3D::dotProduct(p - a, ab) / ab.lengthSquared() : 0;
+    t = qBound(0., t, 1.);
+    return (p - (a + t * ab)).length();
+}
+} // namespace
+
+TracePolicy Trace::getPolicy() { return policy; }
+void        Trace::setPolicy(const TracePolicy &p) { policy = p; }
+
+void Trace::append(const Vector3D &from, const Vector3D &to, rgb color) {
+    // A vector standing still, e.g. under Id or at a pole of its rotation, adds nothing
+    if (isSamePoint(vertex(from, color), to)) {
+        return;
+    }
+    if (vertices_.isEmpty() or not isSamePoint(vertices_.last(), from)) {
+        runs_.append(vertices_.size());
+        vertices_.append(vertex(from, color));
+        merged_.clear();
+    }
+
+    if (not tryMerge(to, color)) {
+        length_ += (to - point(vertices_.last())).length();
+        merged_.clear();
+        vertices_.append(vertex(to, color));
+    }
+    ++revision_;
+
+    if (policy.maxVertices > 0 and vertices_.size() > policy.maxVertices) {
+        discardOldest();
+    }
+}
+
+bool Trace::tryMerge(const Vector3D &to, rgb color) {
+    // The last segment is replaced by one from its first vertex to the new point
+    if (policy.mergeTolerance <= 0 or vertices_.size() - runs_.last() < 2 or
+        merged_.size() >= MAX_MERGED or not isSameColor(vertices_.last().color, color)) {
+        return false;
+    }
+
+    Vector3D anchor = point(vertices_[vertices_.size() - 2]);
+    Vector3D last = point(vertices_.last());
+    if (distanceToSegment(last, anchor, to) > policy.mergeTolerance) {
+        return false;
+    }
+    for (auto &p : merged_) {
+        if (distanceToSegment(p, anchor, to) > policy.mergeTolerance) {
+            return false;
+        }
+    }
+
+    length_ += (to - anchor).length() - (last - anchor).length();
+    merged_.append(last);
+    vertices_.last() = vertex(to, color);
+    return true;
+}
+
+void Trace::discardOldest() {
+    // A quarter at a time, so the cost of moving the rest is spread over many appends
+    int count = vertices_.size() - policy.maxVertices * 3 / 4;
+    vertices_.remove(0, count);
+
+    QVector<int> runs;
+    for (int i = 0; i < runs_.size(); ++i) {
+        int end = i + 1 < runs_.size() ? runs_[i + 1] : count + vertices_.size();
+        if (end > count) {
+            runs.append(qMax(runs_[i] - count, 0));
+        }
+    }
+    runs_ = runs;
+
+    length_ = 0.;
+    for (int i = 0; i < runs_.size(); ++i) {
+        int end = i + 1 < runs_.size() ? runs_[i + 1] : vertices_.size();
+        for (int j = runs_[i] + 1; j < end; ++j) {
+            length_ += (point(vertices_[j]) - point(vertices_[j - 1])).length();
+        }
+    }
+    ++generation_;
+}
+
+int Trace::countOfBytes() const {
+    return vertices_.capacity() * static_cast<int>(sizeof(TraceVertex)) +
+           runs_.capacity() * static_cast<int>(sizeof(int)) +
+           merged_.capacity() * static_cast<int>(sizeof(Vector3D));
+}
+
+void Trace::clear() {
+    vertices_.clear();
+    runs_.clear();
+    merged_.clear();
+    length_ = 0.;
+    ++generation_;
+    ++revision_;
+}
+
+void Trace::assign(const tracearrays &arrays) {
+    vertices_.resize(arrays.countOfVertices);
+    std::copy(arrays.vertices, arrays.vertices + arrays.countOfVertices, vertices_.begin());
+    runs_.resize(arrays.countOfRuns);
+    std::copy(arrays.runs, arrays.runs + arrays.countOfRuns, runs_.begin());
+    merged_.clear();
+    length_ = arrays.length;
+    ++generation_;
+    ++revision_;
+}
+
+tracearrays Trace::arrays() const {
+    tracearrays arrays = {vertices_.constData(), vertices_.size(), runs_.constData(), runs_.size(),
+                          length_};
+    return arrays;
+}
@@ -0,0 +1,111 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TRACE_HPP
+#define TRACE_HPP
+
+#include "Vector3D.h"
+#include <QVector>
+
+struct rgb {
+    float red;
+    float green;
+    float blue;
+};
+
+namespace Color {
+const rgb RED = {1.f, 0.f, 0.f};
+const rgb GREEN = {0.f, 1.f, 0.f};
+const rgb BLUE = {0.f, 0.f, 1.f};
+const rgb GRAY = {160 / 255.f, 160 / 255.f, 164 / 255.f};
+const rgb YELLOW = {1.f, 1.f, 0.f};
+const rgb MAGENTA = {1.f, 0.f, 1.f};
+const rgb CYAN = {0.f, 1.f, 1.f};
+const rgb BLACK = {0.f, 0.f, 0.f};
+} // namespace Color
+
+// Interleaved position and colour, laid out to be uploaded to a vertex buffer as is
+struct TraceVertex {
+    float x;
+    float y;
+    float z;
+    rgb   color;
+};
+
+// Vertices and runs of a trace kept outside of it, e.g. in a mapped session file
+struct tracearrays {
+    const TraceVertex *vertices;
+    int                countOfVertices;
+    const qint32      *runs;
+    int                countOfRuns;
+    double             length;
+};
+
+// How a Trace keeps its memory and draw cost bounded
+struct TracePolicy {
+    // A vertex is dropped when every point merged into the segment stays within this distance
+    // of the segment; zero keeps every vertex
+    double mergeTolerance = 0.0005;
+    // The oldest vertices are discarded beyond this count; zero means no limit
+    int maxVertices = 200000;
+    // Segments shorter than this on screen are skipped when drawing; zero draws every segment
+    double lodPixels = 1.;
+};
+
+// Path a vector has gone through, kept as polylines (runs) of vertices. A segment takes the
+// colour of its second vertex. Vertices are only ever appended until clear(), so a consumer can
+// copy the new ones incrementally. Merging may rewrite the last vertex, which bumps revision();
+// generation() changes whenever the earlier vertices are no longer valid (clear, or discarding the
+// oldest ones once the policy's limit is reached).
+class Trace {
+public:
+    void append(const Vector3D &from, const Vector3D &to, rgb color);
+    void clear();
+    // Replaces the trace with a copy of the arrays, as a new generation
+    void assign(const tracearrays &arrays);
+    // The arrays of the trace, valid until it changes
+    tracearrays arrays() const;
+
+    inline int                         size() const { return vertices_.size(); }
+    inline bool                        isEmpty() const { return vertices_.isEmpty(); }
+    inline const QVector<TraceVertex> &vertices() const { return vertices_; }
+    // Index of the first vertex of each run
+    inline const QVector<int> &runs() const { return runs_; }
+    inline int                 countOfSegments() const { return size() - runs_.size(); }
+    inline unsigned            generation() const { return generation_; }
+    inline unsigned            revision() const { return revision_; }
+    // Sum of the segment lengths
+    inline double length() const { return length_; }
+    // Heap memory held by the trace
+    int countOfBytes() const;
+
+    static TracePolicy getPolicy();
+    static void        setPolicy(const TracePolicy &policy);
+
+private:
+    QVector<TraceVertex> vertices_;
+    QVector<int>         runs_;
+    // Points already merged into the last segment
+    QVector<Vector3D> merged_;
+    double            length_ = 0.;
+    unsigned          generation_ = 0;
+    unsigned          revision_ = 0;
+
+    bool tryMerge(const Vector3D &to, rgb color);
+    void discardOldest();
+};
+
+#endif // TRACE_HPP
@@ -15,6 +15,67 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "UnitaryMatrix2x2.h"
+#include "Gates.h"
+
+namespace {
+// The phase is taken from a while |a|^2 >= LEADING_NORM, otherwise from b (|a| = |d| and
+// |b| = |c| for unitary matrices, so one of them is at least 1/sqrt(2) in modulus). The threshold
+// keeps away from the |a|^2 of common gates (0, 1/4, 1/2, 3/4, 1) so rounding noise does not
+// switch the entry
+const double LEADING_NORM = 0.3;
+
+complex entry(const matrix2x2 &m, int k) {
+    switch (k) {
+    case 0:
+        return m.a;
+    case 1:
+        return m.b;
+    case 2:
+        return m.c;
+    default:
+        return m.d;
+    }
+}
+
+int leadingEntry(const matrix2x2 &m) {
+    if (std::norm(m.a) >= LEADING_NORM) {
+        return 0;
+    }
+    for (int k = 1; k < 4; ++k) {
+        if (std::abs(entry(m, k)) > EPSILON) {
+            return k;
+        }
+    }
+    return 0;
+}
+
+matrix2x2 removePhase(const matrix2x2 &m, int lead) {
+    complex e = entry(m, lead);
+    double  r = std::abs(e);
+    if (r <= EPSILON) {
+        return m;
+    }
+    complex phase = std::conj(e) / r;
+    return {m.a * phase, m.b * phase, m.c * phase, m.d * phase};
+}
+} // namespace
+
+bool canonicalmatrix::operator==(const canonicalmatrix &key) const {
+    for (int k = 0; k < 8; ++k) {
+        if (v[k] != key.v[k]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+uint qHash(const canonicalmatrix &key, uint seed) {
+    uint h = seed;
+    for (int k = 0; k < 8; ++k) {
+        h ^= uint(key.v[k]) + 0x9e3779b9u + (h << 6) + (h >> 2);
+    }
+    return h;
+}
 
 bool UnitaryMatrix2x2::updateMatrix(matrix2x2 matrix) {
     if (isUnitaryMatrix(matrix)) {
@@ -42,45 +103,13 @@ void UnitaryMatrix2x2::print(std::ostream &out) const {
 }
 
 bool UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2 op1, UnitaryMatrix2x2 op2, bool verbose) {
-    bool cmp = true;
-    cmp &= Utility::fuzzyCompare(op1.a().real(), op2.a().real());
-    cmp &= Utility::fuzzyCompare(op1.a().imag(), op2.a().imag());
-
-    cmp &= Utility::fuzzyCompare(op1.b().real(), op2.b().real());
-    cmp &= Utility::fuzzyCompare(op1.b().imag(), op2.b().imag());
-
-    cmp &= Utility::fuzzyCompare(op1.c().real(), op2.c().real());
-    cmp &= Utility::fuzzyCompare(op1.c().imag(), op2.c().imag());
-
-    cmp &= Utility::fuzzyCompare(op1.d().real(), op2.d().real());
-    cmp &= Utility::fuzzyCompare(op1.d().imag(), op2.d().imag());
-
-    if (!cmp) {
-        cmp = true;
-        complex ephi(1, 0);
-        if (std::abs(op2.a() + op2.b()) < EPSILON) {
-            ephi = (op2.a() - op2.b()) / (op1.a() - op1.b());
-        } else {
-            ephi = (op2.a() + op2.b()) / (op1.a() + op1.b());
-        }
-
-        complex a = op2.a() / ephi;
-        complex b = op2.b() / ephi;
-        complex c = op2.c() / ephi;
-        complex d = op2.d() / ephi;
+    // Both sides lose the phase of the same entry, so a single pass decides equality up to phase
+    int       lead = leadingEntry(op1._matrix);
+    matrix2x2 m1 = removePhase(op1._matrix, lead);
+    matrix2x2 m2 = removePhase(op2._matrix, lead);
 
-        cmp &= Utility::fuzzyCompare(op1.a().real(), a.real());
-        cmp &= Utility::fuzzyCompare(op1.a().imag(), a.imag());
-
-        cmp &= Utility::fuzzyCompare(op1.b().real(), b.real());
-        cmp &= Utility::fuzzyCompare(op1.b().imag(), b.imag());
-
-        cmp &= Utility::fuzzyCompare(op1.c().real(), c.real());
-        cmp &= Utility::fuzzyCompare(op1.c().imag(), c.imag());
-
-        cmp &= Utility::fuzzyCompare(op1.d().real(), d.real());
-        cmp &= Utility::fuzzyCompare(op1.d().imag(), d.imag());
-    }
+    bool cmp = Utility::fuzzyCompare(m1.a, m2.a) && Utility::fuzzyCompare(m1.b, m2.b) &&
+               Utility::fuzzyCompare(m1.c, m2.c) && Utility::fuzzyCompare(m1.d, m2.d);
 
     if (verbose && !cmp) {
         std::cout << "----------------------------------------------\n";
@@ -100,6 +129,32 @@ bool UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2 op1, UnitaryMatrix2x2 o
     return cmp;
 }
 
+matrix2x2 UnitaryMatrix2x2::getCanonicalMatrix() const {
+    return removePhase(_matrix, leadingEntry(_matrix));
+}
+
+double UnitaryMatrix2x2::getCanonicalPhase() const {
+    complex e = entry(_matrix, leadingEntry(_matrix));
+    return std::abs(e) <= EPSILON ? 0. : std::arg(e);
+}
+
+canonicalmatrix UnitaryMatrix2x2::getCanonical() const {
+    matrix2x2       m = getCanonicalMatrix();
+    complex         entries[] = {m.a, m.b, m.c, m.d};
+    canonicalmatrix key;
+    for (int k = 0; k < 4; ++k) {
+        key.v[2 * k] = qRound(entries[k].real() / EPSILON);
+        key.v[2 * k + 1] = qRound(entries[k].imag() / EPSILON);
+    }
+    return key;
+}
+
+uint UnitaryMatrix2x2::hash() const { return qHash(getCanonical()); }
+
+bool UnitaryMatrix2x2::operator==(const UnitaryMatrix2x2 &op) const {
+    return getCanonical() == op.getCanonical();
+}
+
 UnitaryMatrix2x2 UnitaryMatrix2x2::getConjugateTranspose() {
     return UnitaryMatrix2x2({conj(_matrix.a), conj(_matrix.c), conj(_matrix.b), conj(_matrix.d)});
 }
@@ -136,21 +191,47 @@ UnitaryMatrix2x2 UnitaryMatrix2x2::operator-() {
     return UnitaryMatrix2x2({a, b, c, d});
 }
 
-UnitaryMatrix2x2 UnitaryMatrix2x2::getId() { return UnitaryMatrix2x2({1, 0, 0, 1}); }
-UnitaryMatrix2x2 UnitaryMatrix2x2::getX() { return UnitaryMatrix2x2({0, 1, 1, 0}); }
-UnitaryMatrix2x2 UnitaryMatrix2x2::getY() {
-    return UnitaryMatrix2x2({0, -complex(0, 1), complex(0, 1), 0});
+Quaternion UnitaryMatrix2x2::toQuaternion() const {
+    // Divided by a square root of the determinant the matrix is in SU(2):
+    // ((w - iz, -y - ix), (y - ix, w + iz))
+    complex   root = std::sqrt(_matrix.a * _matrix.d - _matrix.b * _matrix.c);
+    matrix2x2 m = {_matrix.a / root, _matrix.b / root, _matrix.c / root, _matrix.d / root};
+    double    w = (m.a.real() + m.d.real()) / 2;
+    double    x = -(m.b.imag() + m.c.imag()) / 2;
+    double    y = (m.c.real() - m.b.real()) / 2;
+    double    z = (m.d.imag() - m.a.imag()) / 2;
+
+    // q and -q are the same rotation; a half turn keeps the axis with its first nonzero
+    // coordinate positive
+    bool negate = w < -EPSILON;
+    if (std::abs(w) <= EPSILON) {
+        double first = std::abs(x) > EPSILON ? x : std::abs(y) > EPSILON ? y : z;
+        negate = first < 0;
+    }
+    if (negate) {
+        return Quaternion(-w, -x, -y, -z).normalized();
+    }
+    return Quaternion(w, x, y, z).normalized();
 }
-UnitaryMatrix2x2 UnitaryMatrix2x2::getZ() { return UnitaryMatrix2x2({1, 0, 0, -1}); }
-UnitaryMatrix2x2 UnitaryMatrix2x2::getH() {
-    double h = 1 / sqrt(2);
-    return UnitaryMatrix2x2({h, h, h, -h});
+
+UnitaryMatrix2x2 UnitaryMatrix2x2::fromQuaternion(const Quaternion &q) {
+    Quaternion n = q.normalized();
+    return UnitaryMatrix2x2({complex(n.scalar(), -n.z()), complex(-n.y(), -n.x()),
+                             complex(n.y(), -n.x()), complex(n.scalar(), n.z())});
 }
-UnitaryMatrix2x2 UnitaryMatrix2x2::getS() { return UnitaryMatrix2x2({1, 0, 0, complex(0, 1)}); }
-UnitaryMatrix2x2 UnitaryMatrix2x2::getT() {
-    return UnitaryMatrix2x2({1, 0, 0, exp(complex(0, 1) * (M_PI / 4))});
+
+UnitaryMatrix2x2 UnitaryMatrix2x2::getGate(int gate) {
+    return UnitaryMatrix2x2(Gates::TABLE[gate].matrix);
 }
 
+UnitaryMatrix2x2 UnitaryMatrix2x2::getId() { return getGate(Gates::ID); }
+UnitaryMatrix2x2 UnitaryMatrix2x2::getX() { return getGate(Gates::X); }
+UnitaryMatrix2x2 UnitaryMatrix2x2::getY() { return getGate(Gates::Y); }
+UnitaryMatrix2x2 UnitaryMatrix2x2::getZ() { return getGate(Gates::Z); }
+UnitaryMatrix2x2 UnitaryMatrix2x2::getH() { return getGate(Gates::H); }
+UnitaryMatrix2x2 UnitaryMatrix2x2::getS() { return getGate(Gates::S); }
+UnitaryMatrix2x2 UnitaryMatrix2x2::getT() { return getGate(Gates::T); }
+
 UnitaryMatrix2x2 UnitaryMatrix2x2::getPhi(double gamma) {
     return UnitaryMatrix2x2({exp(C_I * gamma), 0, 0, 1});
 }
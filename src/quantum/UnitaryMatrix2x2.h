@@ -17,6 +17,7 @@
 #ifndef UNITARYMATRIX2X2_HPP
 #define UNITARYMATRIX2X2_HPP
 
+#include "Quaternion.h"
 #include "Qubit.h"
 #include <iostream>
 #include <ostream>
@@ -39,6 +40,17 @@ struct matrix2x2 {
     complex d;
 };
 
+// Operator with the global phase removed and the entries rounded to multiples of EPSILON
+// (re a, im a, re b, im b, ...). Operators equal up to phase have equal keys
+struct canonicalmatrix {
+    qint32 v[8];
+
+    bool operator==(const canonicalmatrix &key) const;
+    bool operator!=(const canonicalmatrix &key) const { return !(*this == key); }
+};
+
+uint qHash(const canonicalmatrix &key, uint seed = 0);
+
 class UnitaryMatrix2x2 {
 public:
     explicit UnitaryMatrix2x2() {
@@ -55,6 +67,17 @@ public:
     UnitaryMatrix2x2 getConjugateTranspose();
     void             print(std::ostream &out) const;
 
+    // Matrix divided by the phase of its leading entry
+    matrix2x2       getCanonicalMatrix() const;
+    double          getCanonicalPhase() const; // rad
+    canonicalmatrix getCanonical() const;
+    uint            hash() const;
+    // Equality of the canonical keys, as QHash needs it to agree with qHash. Operators within
+    // rounding noise of a grid boundary can differ here while compareOperators(), the tolerant
+    // comparison, finds them equal.
+    bool operator==(const UnitaryMatrix2x2 &op) const;
+    bool operator!=(const UnitaryMatrix2x2 &op) const { return !(*this == op); }
+
     complex a() const { return _matrix.a; }
     complex b() const { return _matrix.b; }
     complex c() const { return _matrix.c; }
@@ -64,6 +87,13 @@ public:
     QString cStr() const { return Utility::parseComplexToStr(_matrix.c); }
     QString dStr() const { return Utility::parseComplexToStr(_matrix.d); }
 
+    // The Bloch sphere rotation of the operator as a unit quaternion, with scalar part >= 0. The
+    // conversions are exact: fromQuaternion(q) is the SU(2) matrix of q
+    Quaternion              toQuaternion() const;
+    static UnitaryMatrix2x2 fromQuaternion(const Quaternion &q);
+
+    // Matrix of the named gate Gates::GATE gate
+    static UnitaryMatrix2x2 getGate(int gate);
     static UnitaryMatrix2x2 getId();
     static UnitaryMatrix2x2 getX();
     static UnitaryMatrix2x2 getY();
@@ -87,4 +117,8 @@ private:
     // Matrices must be unitary
     explicit UnitaryMatrix2x2(matrix2x2 matrix) : _matrix(matrix) {}
 };
+
+inline uint qHash(const UnitaryMatrix2x2 &op, uint seed = 0) {
+    return qHash(op.getCanonical(), seed);
+}
 #endif // UNITARYMATRIX2X2_HPP
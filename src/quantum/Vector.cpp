@@ -25,42 +25,38 @@ Vector::Vector(double the, double phi) : Qubit(the, phi) { initialSpike(); }
 
 Vector::Vector(complex a, complex b) : Qubit(a, b) { initialSpike(); }
 
-Spike Vector::getSpike() const {
-    if (path_.empty()) {
-        return spike_;
-    } else {
-        return path_.last();
-    }
-}
+// While the path plays, spike_ holds its frame at position pathFrame_
+Spike Vector::getSpike() const { return spike_; }
 
 void Vector::popPath() {
-    assert(not path_.isEmpty());
-    if (path_.size() > 1) {
-        tracePushBack();
+    assert(hasPath());
+    pathFrame_ = std::floor(pathFrame_) + 1;
+    if (pathFrame_ < path_.size()) {
+        Spike next = path_.frame(static_cast<int>(pathFrame_));
+        tracePushBack(next);
+        spike_ = next;
     }
-    spike_ = path_.last();
-    path_.pop_back();
 }
 
 void Vector::changeVector(Spike s) {
-    path_.clear();
+    ++revision_;
+    path_ = Path();
+    pathFrame_ = 0;
     spike_ = s;
-    this->changeQubit(s.point.x(), s.point.y(), s.point.z());
-}
-
-void Vector::changeVector(QVector<Spike> s) {
-    path_ = normalizePath(s);
-    spike_ = s.last();
-    this->changeQubit(s.first().point.x(), s.first().point.y(), s.first().point.z());
+    if (s.point.normalized().lengthSquared() > 0) {
+        this->changeQubit(s.point.x(), s.point.y(), s.point.z());
+    }
 }
 
-Spike Vector::actOperator(QQuaternion q, Spike s) {
-    s.point = q.rotatedVector(s.point);
-    s.arrow1 = q.rotatedVector(s.arrow1);
-    s.arrow2 = q.rotatedVector(s.arrow2);
-    s.arrow3 = q.rotatedVector(s.arrow3);
-    s.arrow4 = q.rotatedVector(s.arrow4);
-    return s;
+void Vector::changeVector(const Path &p) {
+    ++revision_;
+    path_ = p;
+    pathFrame_ = 0;
+    spike_ = p.frame(0);
+    Spike last = p.last();
+    if (last.point.normalized().lengthSquared() > 0) {
+        this->changeQubit(last.point.x(), last.point.y(), last.point.z());
+    }
 }
 
 void Vector::printVector() const {
@@ -74,29 +70,61 @@ void Vector::printVector() const {
     qDebug() << "---------------";
 }
 
-void Vector::tracePushBack() {
-    Trace tr;
-    tr.first = QVector3D(path_[path_.size() - 2].point.x(), path_[path_.size() - 2].point.y(),
-                         path_[path_.size() - 2].point.z());
-    tr.last = getSpike().point;
-    tr.color = traceColor_;
-    trace_.append(tr);
+void Vector::setSelfColor(rgb color) {
+    selfColor_ = color;
+    ++revision_;
+}
+
+void Vector::setTraceColor(rgb color) {
+    traceColor_ = color;
+    ++revision_;
+}
+
+void Vector::setEnableTrace(bool b) {
+    traceEnabled_ = b;
+    ++revision_;
+}
+
+void Vector::clearTrace() {
+    trace_.clear();
+    ++revision_;
+}
+
+void Vector::assignTrace(const tracearrays &arrays) {
+    trace_.assign(arrays);
+    ++revision_;
+}
+
+void Vector::setEnabledRotateVector(bool f) {
+    _isRotateVectorEnable = f;
+    ++revision_;
+}
+
+void Vector::setRotateVector(Vector3D v) {
+    _rotateVector = v;
+    ++revision_;
+}
+
+void Vector::setName(QString str) {
+    _name = str;
+    ++revision_;
+}
+
+void Vector::setOperator(QString str) {
+    _operator = str;
+    ++revision_;
+}
+
+void Vector::tracePushBack(const Spike &next) {
+    trace_.append(spike_.point, next.point, traceColor_);
+    ++revision_;
 }
 
 void Vector::initialSpike() { spike_ = createSpike(x(), y(), z()); }
 
 Spike Vector::createSpike(double x, double y, double z) {
     Spike s;
-#if QT_VERSION >= 0x050000
-    QQuaternion q = QQuaternion::rotationTo(QVector3D(0, 0, 1), QVector3D(x, y, z));
-#else
-    QQuaternion q = QQuaternionrotationTo(QVector3D(0, 0, 1), QVector3D(x, y, z));
-#endif
-    s.point = QVector3D(x, y, z);
-    s.arrow1 = q.rotatedVector(QVector3D(0.02, 0.0, 0.9));
-    s.arrow2 = q.rotatedVector(QVector3D(-0.02, 0.0, 0.9));
-    s.arrow3 = q.rotatedVector(QVector3D(0.0, 0.02, 0.9));
-    s.arrow4 = q.rotatedVector(QVector3D(0.0, -0.02, 0.9));
+    s.point = Vector3D(x, y, z);
     return s;
 }
 
@@ -110,25 +138,12 @@ Spike Vector::createSpike(double a, complex b) {
     return createSpike(q.x(), q.y(), q.z());
 }
 
-QVector<Spike> Vector::normalizePath(const QVector<Spike> &s) {
-    QVector<Spike> newS;
-    int            dur = Utility::getDuration();
-    newS.append(s.first());
-    if (dur != 0) {
-        int step = s.size() / dur;
-        for (int i = 1; i < s.size() - 1; i += step) {
-            newS.append(s[i]);
-        }
-    }
-    newS.append(s.last());
-    return newS;
-}
-
 Vector *Vector::getCopyState() {
     auto v = new Vector();
 
     v->spike_ = spike_;
     v->path_ = path_;
+    v->pathFrame_ = pathFrame_;
     v->trace_ = trace_;
     v->selfColor_ = selfColor_;
     v->traceColor_ = traceColor_;
@@ -144,39 +159,37 @@ void Vector::takeStep() {
         isNowAnimate_ = false;
     }
 }
+
+void Vector::advance(double frames) {
+    if (not hasPath()) {
+        isNowAnimate_ = false;
+        return;
+    }
+
+    // Like popPath, the step after the last frame only finishes the path
+    double last = path_.size() - 1;
+    if (pathFrame_ >= last) {
+        pathFrame_ = path_.size();
+        return;
+    }
+    pathFrame_ = qMin(pathFrame_ + frames, last);
+    Spike next = path_.frameAt(pathFrame_);
+    tracePushBack(next);
+    spike_ = next;
+}
+
 void Vector::setColorByNameIndex() {
     if (_name == "") {
-        setSelfColor(Qt::red);
+        setSelfColor(Color::RED);
     } else if (_name == "1") {
-        setSelfColor(Qt::red);
+        setSelfColor(Color::RED);
     } else if (_name == "2") {
-        setSelfColor(Qt::green);
+        setSelfColor(Color::GREEN);
     } else if (_name == "3") {
-        setSelfColor(Qt::yellow);
+        setSelfColor(Color::YELLOW);
     } else if (_name == "4") {
-        setSelfColor(Qt::magenta);
+        setSelfColor(Color::MAGENTA);
     } else if (_name == "5") {
-        setSelfColor(Qt::cyan);
-    }
-}
-
-#if QT_VERSION < 0x050000
-QQuaternion QQuaternionrotationTo(const QVector3D &from, const QVector3D &to) {
-    // Based on Stan Melax's article in Game Programming Gems
-    const QVector3D v0(from.normalized());
-    const QVector3D v1(to.normalized());
-    float           d = QVector3D::dotProduct(v0, v1) + 1.0f;
-    // if dest vector is close to the inverse of source vector, ANY axis of rotation is valid
-    if (qFuzzyIsNull(d)) {
-        QVector3D axis = QVector3D::crossProduct(QVector3D(1.0f, 0.0f, 0.0f), v0);
-        if (qFuzzyIsNull(axis.lengthSquared()))
-            axis = QVector3D::crossProduct(QVector3D(0.0f, 1.0f, 0.0f), v0);
-        axis.normalize();
-        // same as QQuaternion::fromAxisAndAngle(axis, 180.0f)
-        return QQuaternion(0.0f, axis.x(), axis.y(), axis.z());
+        setSelfColor(Color::CYAN);
     }
-    d = std::sqrt(2.0f * d);
-    const QVector3D axis(QVector3D::crossProduct(v0, v1) / d);
-    return QQuaternion(d * 0.5f, axis).normalized();
 }
-#endif
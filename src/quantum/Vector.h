@@ -17,13 +17,13 @@
 #ifndef VECTOR_HPP
 #define VECTOR_HPP
 
+#include "Path.h"
+#include "Quaternion.h"
 #include "Qubit.h"
-#include <QColor>
+#include "Trace.h"
+#include "Vector3D.h"
 #include <QDebug>
-#include <QObject>
-#include <QQuaternion>
-#include <QTimerEvent>
-#include <QVector3D>
+#include <QVector>
 #include <utility>
 
 #if QT_VERSION >= 0x050000
@@ -32,56 +32,46 @@
 inline double qDegreesToRadians(double degrees) { return degrees * (M_PI / 180); }
 
 inline double qRadiansToDegrees(double radians) { return radians * (180 / M_PI); }
-
-QQuaternion QQuaternionrotationTo(const QVector3D &from, const QVector3D &to);
 #endif
 
-struct Trace {
-    QVector3D first;
-    QVector3D last;
-    QColor    color;
-};
-
-struct Spike {
-    QVector3D point;
-    QVector3D arrow1;
-    QVector3D arrow2;
-    QVector3D arrow3;
-    QVector3D arrow4;
-};
-
-class Vector : public QObject, public Qubit {
-    Q_OBJECT
+class Vector : public Qubit {
 public:
     Vector();
     Vector(double x, double y, double z);
     Vector(double the, double phi);
     Vector(complex a, complex b);
 
-    inline QColor                getSelfColor() const { return selfColor_; }
-    inline void                  setSelfColor(QColor color) { selfColor_ = color; }
+    inline rgb                   getSelfColor() const { return selfColor_; }
+    void                         setSelfColor(rgb color);
     void                         setColorByNameIndex();
-    inline QColor                getTraceColor() const { return traceColor_; }
-    inline void                  setTraceColor(QColor color) { traceColor_ = color; }
-    inline void                  setEnableTrace(bool b) { traceEnabled_ = b; }
+    inline rgb                   getTraceColor() const { return traceColor_; }
+    void                         setTraceColor(rgb color);
+    void                         setEnableTrace(bool b);
     inline bool                  isTraceEnabled() const { return traceEnabled_; }
-    inline QVector<Trace> const &getTrace() const { return trace_; }
+    inline const Trace          &getTrace() const { return trace_; }
     Spike                        getSpike() const;
-    inline void                  clearTrace() { trace_.clear(); }
+    void                         clearTrace();
+    void                         assignTrace(const tracearrays &arrays);
+    // Changes whenever anything drawn for the vector changes
+    inline unsigned getRevision() const { return revision_; }
 
-    inline bool hasPath() const { return not path_.empty(); }
+    inline bool hasPath() const { return pathFrame_ < path_.size(); }
+    inline int  getPathSize() const { return path_.size(); }
+    inline int  getPathFrame() const { return static_cast<int>(pathFrame_); }
 
-    void             setEnabledRotateVector(bool f) { _isRotateVectorEnable = f; }
-    void             setRotateVector(QVector3D v) { _rotateVector = v; }
-    bool             isRotateVectorEnable() const { return _isRotateVectorEnable; }
-    const QVector3D &rotateVector() const { return _rotateVector; }
+    void            setEnabledRotateVector(bool f);
+    void            setRotateVector(Vector3D v);
+    bool            isRotateVectorEnable() const { return _isRotateVectorEnable; }
+    const Vector3D &rotateVector() const { return _rotateVector; }
 
     void popPath();
 
+    // The qubit fields follow the direction of the spike; a vector at the centre, a maximally
+    // mixed qubit, keeps the fields it had
     void changeVector(Spike s);
-    void changeVector(QVector<Spike> s);
+    void changeVector(const Path &p);
 
-    static Spike actOperator(QQuaternion q, Spike s);
+    static Spike actOperator(const Quaternion &q, Spike s) { return Path::actOperator(q, s); }
 
     Vector *getCopyState();
 
@@ -89,6 +79,8 @@ public:
 
     bool isNowAnimate() const { return isNowAnimate_; }
     void takeStep();
+    // Moves along the path by a possibly fractional number of frames
+    void advance(double frames);
 
     void setAnimateState(bool animate) { isNowAnimate_ = animate; }
 
@@ -96,26 +88,28 @@ public:
     static Spike createSpike(double the, double phi);
     static Spike createSpike(double a, complex b);
 
-    void    setName(QString str) { _name = str; }
-    void    setOperator(QString str) { _operator = str; }
+    void    setName(QString str);
+    void    setOperator(QString str);
     QString getInfo() { return _name + (_operator == "" ? "" : ": " + _operator); }
+    QString getName() const { return _name; }
 
 private:
     Spike          spike_;
-    QVector<Spike> path_;
-    QVector<Trace> trace_;
-    QColor         selfColor_ = Qt::red;
-    QColor         traceColor_ = Qt::gray;
+    Path           path_;
+    double         pathFrame_ = 0;
+    Trace          trace_;
+    rgb            selfColor_ = Color::RED;
+    rgb            traceColor_ = Color::GRAY;
     bool           traceEnabled_ = true;
     bool           isNowAnimate_ = false;
-    QVector3D      _rotateVector;
+    Vector3D       _rotateVector;
     bool           _isRotateVectorEnable = false;
     QString        _name;
     QString        _operator;
+    unsigned       revision_ = 0;
 
-    void                  tracePushBack();
-    void                  initialSpike();
-    static QVector<Spike> normalizePath(const QVector<Spike> &s);
+    void tracePushBack(const Spike &next);
+    void initialSpike();
 };
 
 #endif // VECTOR_HPP
@@ -0,0 +1,84 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Vector3D.h"
+#include "src/utility.h"
+#include <cmath>
+
+double Vector3D::length() const { return std::sqrt(lengthSquared()); }
+
+Vector3D Vector3D::normalized() const {
+    double len = lengthSquared();
+    if (std::abs(len - 1.0) < EPSILON * EPSILON) {
+        return *this;
+    } else if (len > EPSILON * EPSILON) {
+        return *this / std::sqrt(len);
+    }
+    return Vector3D();
+}
+
+double Vector3D::dotProduct(const Vector3D &v1, const Vector3D &v2) {
+    return v1.x_ * v2.x_ + v1.y_ * v2.y_ + v1.z_ * v2.z_;
+}
+
+Vector3D Vector3D::crossProduct(const Vector3D &v1, const Vector3D &v2) {
+    return Vector3D(v1.y_ * v2.z_ - v1.z_ * v2.y_, v1.z_ * v2.x_ - v1.x_ * v2.z_,
+                    v1.x_ * v2.y_ - v1.y_ * v2.x_);
+}
+
+Vector3D &Vector3D::operator+=(const Vector3D &v) {
+    x_ += v.x_;
+    y_ += v.y_;
+    z_ += v.z_;
+    return *this;
+}
+
+Vector3D &Vector3D::operator-=(const Vector3D &v) {
+    x_ -= v.x_;
+    y_ -= v.y_;
+    z_ -= v.z_;
+    return *this;
+}
+
+Vector3D &Vector3D::operator*=(double f) {
+    x_ *= f;
+    y_ *= f;
+    z_ *= f;
+    return *this;
+}
+
+Vector3D &Vector3D::operator/=(double f) {
+    x_ /= f;
+    y_ /= f;
+    z_ /= f;
+    return *this;
+}
+
+Vector3D operator+(const Vector3D &v1, const Vector3D &v2) {
+    return Vector3D(v1.x_ + v2.x_, v1.y_ + v2.y_, v1.z_ + v2.z_);
+}
+
+Vector3D operator-(const Vector3D &v1, const Vector3D &v2) {
+    return Vector3D(v1.x_ - v2.x_, v1.y_ - v2.y_, v1.z_ - v2.z_);
+}
+
+Vector3D operator-(const Vector3D &v) { return Vector3D(-v.x_, -v.y_, -v.z_); }
+
+Vector3D operator*(double f, const Vector3D &v) { return Vector3D(v.x_ * f, v.y_ * f, v.z_ * f); }
+
+Vector3D operator*(const Vector3D &v, double f) { return Vector3D(v.x_ * f, v.y_ * f, v.z_ * f); }
+
+Vector3D operator/(const Vector3D &v, double f) { return Vector3D(v.x_ / f, v.y_ / f, v.z_ / f); }
@@ -0,0 +1,59 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef VECTOR3D_HPP
+#define VECTOR3D_HPP
+
+// Double precision 3D vector. Mirrors the subset of the QVector3D interface used by the
+// quantum core so that the core does not depend on QtGui.
+class Vector3D {
+public:
+    Vector3D() : x_(0), y_(0), z_(0) {}
+    Vector3D(double x, double y, double z) : x_(x), y_(y), z_(z) {}
+
+    inline double x() const { return x_; }
+    inline double y() const { return y_; }
+    inline double z() const { return z_; }
+    inline void   setX(double x) { x_ = x; }
+    inline void   setY(double y) { y_ = y; }
+    inline void   setZ(double z) { z_ = z; }
+
+    double   length() const;
+    double   lengthSquared() const { return x_ * x_ + y_ * y_ + z_ * z_; }
+    Vector3D normalized() const;
+
+    static double   dotProduct(const Vector3D &v1, const Vector3D &v2);
+    static Vector3D crossProduct(const Vector3D &v1, const Vector3D &v2);
+
+    Vector3D &operator+=(const Vector3D &v);
+    Vector3D &operator-=(const Vector3D &v);
+    Vector3D &operator*=(double f);
+    Vector3D &operator/=(double f);
+
+    friend Vector3D operator+(const Vector3D &v1, const Vector3D &v2);
+    friend Vector3D operator-(const Vector3D &v1, const Vector3D &v2);
+    friend Vector3D operator-(const Vector3D &v);
+    friend Vector3D operator*(double f, const Vector3D &v);
+    friend Vector3D operator*(const Vector3D &v, double f);
+    friend Vector3D operator/(const Vector3D &v, double f);
+
+private:
+    double x_;
+    double y_;
+    double z_;
+};
+
+#endif // VECTOR3D_HPP
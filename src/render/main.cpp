@@ -0,0 +1,280 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "src/cli/BatchJob.h"
+#include "src/widgets/FrameSink.h"
+#include "src/widgets/OffscreenRenderer.h"
+#include <QCommandLineParser>
+#include <QFile>
+#include <QGuiApplication>
+#include <QTextStream>
+#include <thread>
+#include <vector>
+
+namespace {
+// Frames a raw stream holds per thread while it waits for an earlier one
+const int FRAMES_PER_THREAD = 2;
+
+// A frame per path frame, which the window plays every 10 ms
+const int FRAMES_PER_SECOND = 100;
+
+// View of the window when it opens, as Sphere::toNormal sets it
+const spherecamera CAMERA = {1, -60, 0, -135};
+
+// Frames of a job: the starting vectors, then those of each operator or step
+int countOfFrames(const QVector<QVector<Path>> &moves) {
+    int count = 1;
+    for (const QVector<Path> &step : moves) {
+        int longest = 1;
+        for (const Path &path : step) {
+            longest = qMax(longest, path.size());
+        }
+        count += longest - 1;
+    }
+    return count;
+}
+
+// Replays the job as the window animates it, a frame per Vector::takeStep(), and renders the frames
+// first, first + stride and so on, numbered from base. Every thread replays the whole job, which
+// costs little next to rendering, so that each frame has its whole trace.
+bool renderFrames(OffscreenRenderer *renderer, const BatchJob &job,
+                  const QVector<QVector<Path>> &moves, int first, int stride, int base,
+                  FrameSink *sink) {
+    QVector<Vector3D> starts = job.startingVectors();
+    QVector<Vector>   vectors;
+    for (int q = 0; q < starts.size(); ++q) {
+        vectors.append(Vector(starts[q].x(), starts[q].y(), starts[q].z()));
+        vectors[q].setName(QString::number(q + 1));
+        vectors[q].setColorByNameIndex();
+    }
+    QList<Vector *> drawn;
+    for (Vector &v : vectors) {
+        drawn.append(&v);
+    }
+
+    renderer->begin();
+    bool isSuccess = true;
+    int  frame = 0;
+    auto renderFrame = [&]() {
+        if (isSuccess and frame % stride == first) {
+            isSuccess = sink->put(base + frame, renderer->render(CAMERA, drawn));
+        }
+        ++frame;
+    };
+
+    renderFrame();
+    for (const QVector<Path> &step : moves) {
+        int longest = 1;
+        for (int q = 0; q < step.size(); ++q) {
+            vectors[q].changeVector(step[q]);
+            longest = qMax(longest, step[q].size());
+        }
+        for (int k = 1; isSuccess and k < longest; ++k) {
+            for (Vector &v : vectors) {
+                v.takeStep();
+            }
+            renderFrame();
+        }
+    }
+    renderer->end();
+    return isSuccess;
+}
+} // namespace
+
+int main(int argc, char *argv[]) {
+    QGuiApplication app(argc, argv);
+    QGuiApplication::setApplicationName("blochsphere-render");
+    QGuiApplication::setApplicationVersion(BLOCHSPHERE_VERSION);
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription(
+        "Renders the animations of job files as the window plays them, without a window: a PNG "
+        "file per frame or one raw RGBA stream. Runs under QT_QPA_PLATFORM=offscreen.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    QCommandLineOption outputOption(QStringList() << "o"
+                                                  << "output",
+                                    "Write a PNG file per frame named by <pattern>, with %1 for "
+                                    "the frame number; frame-%1.png by default.",
+                                    "pattern");
+    QCommandLineOption rawOption("raw",
+                                 "Write the frames as one raw RGBA stream to <file>, - for "
+                                 "stdout, e.g. into ffmpeg -f rawvideo -pix_fmt rgba.",
+                                 "file");
+    QCommandLineOption y4mOption("y4m",
+                                 "Write the frames as one YUV4MPEG2 video to <file>, - for "
+                                 "stdout, at the speed of the window.",
+                                 "file");
+    QCommandLineOption sizeOption(QStringList() << "s"
+                                                << "size",
+                                  "Render frames of <width>x<height>, 512x512 by default.", "size");
+    QCommandLineOption trajectoryOption(QStringList() << "t"
+                                                      << "trajectory",
+                                        "Move the vectors along <path>: zx, zy, xy, zyx, operator "
+                                        "or vector; zy by default.",
+                                        "path");
+    QCommandLineOption jobsOption(QStringList() << "j"
+                                                << "jobs",
+                                  "Render <n> frames at once, each thread with a GL context of "
+                                  "its own, as many as the processor has threads by default.",
+                                  "n");
+    QCommandLineOption softwareOption("software",
+                                      "Paint the frames with QPainter, without OpenGL.");
+    QCommandLineOption engineOption("engine",
+                                    "Decompose the operators with the legacy or the fast "
+                                    "engine; legacy by default.",
+                                    "name");
+    parser.addOption(outputOption);
+    parser.addOption(rawOption);
+    parser.addOption(y4mOption);
+    parser.addOption(sizeOption);
+    parser.addOption(trajectoryOption);
+    parser.addOption(jobsOption);
+    parser.addOption(engineOption);
+    parser.addOption(softwareOption);
+    parser.addPositionalArgument("files", "Job files, standard input if none or -.", "[files...]");
+    parser.process(app);
+
+    BatchJob::TRAJECTORY trajectory = BatchJob::ZY;
+    QSize                size(512, 512);
+    int                  threads = qMax(1, static_cast<int>(std::thread::hardware_concurrency()));
+    if (parser.isSet(trajectoryOption)) {
+        bool ok = false;
+        trajectory = BatchJob::trajectoryByName(parser.value(trajectoryOption), &ok);
+        if (not ok) {
+            QTextStream(stderr) << "unknown trajectory " << parser.value(trajectoryOption) << "\n";
+            return 2;
+        }
+    }
+    if (parser.isSet(engineOption)) {
+        bool                        ok = false;
+        DecompositionKernel::ENGINE engine =
+            DecompositionKernel::engineByName(parser.value(engineOption), &ok);
+        if (not ok) {
+            QTextStream(stderr) << "unknown engine " << parser.value(engineOption) << "\n";
+            return 2;
+        }
+        DecompositionKernel::setEngine(engine);
+    }
+    if (parser.isSet(sizeOption)) {
+        QStringList sides = parser.value(sizeOption).split('x');
+        bool        okWidth = false, okHeight = false;
+        if (sides.size() == 2) {
+            size = QSize(sides[0].toInt(&okWidth), sides[1].toInt(&okHeight));
+        }
+        if (not(okWidth and okHeight) or size.isEmpty()) {
+            QTextStream(stderr) << "size needs <width>x<height>, e.g. 640x480\n";
+            return 2;
+        }
+    }
+    if (parser.isSet(jobsOption)) {
+        bool ok = false;
+        threads = parser.value(jobsOption).toInt(&ok);
+        if (not ok or threads < 1) {
+            QTextStream(stderr) << "jobs needs a positive number\n";
+            return 2;
+        }
+    }
+
+    QFile      out;
+    FrameSink *sink = nullptr;
+    if (parser.isSet(rawOption) or parser.isSet(y4mOption)) {
+        QString name = parser.value(parser.isSet(rawOption) ? rawOption : y4mOption);
+        out.setFileName(name);
+        bool isOpen = name == "-" ? out.open(stdout, QIODevice::WriteOnly)
+                                  : out.open(QIODevice::WriteOnly | QIODevice::Truncate);
+        if (not isOpen) {
+            QTextStream(stderr) << name << ": " << out.errorString() << "\n";
+            return 2;
+        }
+        if (parser.isSet(rawOption)) {
+            sink = new RawFrameSink(&out, FRAMES_PER_THREAD * threads);
+        } else {
+            sink = new Y4mFrameSink(&out, FRAMES_PER_THREAD * threads, FRAMES_PER_SECOND);
+        }
+    } else {
+        QString pattern = parser.isSet(outputOption) ? parser.value(outputOption)
+                                                     : QString("frame-%1.png");
+        if (not pattern.contains("%1")) {
+            QTextStream(stderr) << "output needs %1 for the frame number\n";
+            return 2;
+        }
+        sink = new PngFrameSink(pattern);
+    }
+
+    // Surfaces are made on this thread, the contexts on the workers
+    QVector<OffscreenRenderer *> renderers;
+    for (int t = 0; t < threads; ++t) {
+        renderers.append(new OffscreenRenderer(size, parser.isSet(softwareOption)));
+    }
+
+    QStringList files = parser.positionalArguments();
+    if (files.isEmpty()) {
+        files << "-";
+    }
+    int exitCode = 0;
+    int base = 0;
+    for (const QString &name : files) {
+        QFile in(name);
+        bool  isOpen = name == "-" ? in.open(stdin, QIODevice::ReadOnly)
+                                   : in.open(QIODevice::ReadOnly);
+        if (not isOpen) {
+            QTextStream(stderr) << name << ": " << in.errorString() << "\n";
+            exitCode = 1;
+            continue;
+        }
+
+        BatchReader reader(&in, name == "-" ? QString("stdin") : name);
+        BatchJob    job;
+        QString     error;
+        while (exitCode != 2 and reader.next(&job, &error)) {
+            if (not error.isEmpty()) {
+                QTextStream(stderr) << error << "\n";
+                exitCode = 1;
+                continue;
+            }
+
+            QVector<QVector<Path>>   moves = job.paths(trajectory);
+            std::vector<char>        results(threads);
+            std::vector<std::thread> workers;
+            for (int t = 0; t < threads; ++t) {
+                workers.emplace_back([&, t]() {
+                    results[t] = renderFrames(renderers[t], job, moves, t, threads, base, sink);
+                });
+            }
+            for (std::thread &worker : workers) {
+                worker.join();
+            }
+            for (char result : results) {
+                if (not result) {
+                    QTextStream(stderr) << job.getSource() << ": " << sink->errorString() << "\n";
+                    exitCode = 2;
+                    break;
+                }
+            }
+            base += countOfFrames(moves);
+        }
+    }
+    if (exitCode != 2 and not sink->finish()) {
+        QTextStream(stderr) << sink->errorString() << "\n";
+        exitCode = 2;
+    }
+
+    qDeleteAll(renderers);
+    delete sink;
+    return exitCode;
+}
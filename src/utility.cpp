@@ -22,15 +22,11 @@
 
 namespace {
 int speed = 5;
-QRegExpValidator
-    cmpVld(QRegExp(QString::fromUtf8("^[+-]?[0-9]*\\.?[0-9]*[+-]?[0-9]*\\.?[0-9]*[iIшШ]?$")));
-QRegExpValidator axsVld(QRegExp("^-?[\\d]*\\.?[\\d]*;?-?[\\d]*\\.?[\\d]*;?-?[\\d]*\\.?[\\d]*$"));
+int maxCountOfSpheres = 32;
+int maxCountOfSteps = 100000;
 } // namespace
 
 namespace Utility {
-const QValidator *compValid() { return &cmpVld; }
-const QValidator *axisValid() { return &axsVld; }
-
 double getDuration() { return DURATION * (11 - speed); }
 
 double roundNumber(double a, double s) {
@@ -102,17 +98,16 @@ QString numberToStr(double d) { return QString::number(roundNumber(d)); }
 QString numberToStr(long d) { return QString::number(d); }
 double  getSpeed() { return speed; }
 void    setSpeed(int spd) { speed = spd; }
+int     getMaxCountOfSpheres() { return maxCountOfSpheres; }
+void    setMaxCountOfSpheres(int count) { maxCountOfSpheres = qMax(1, count); }
+int     getMaxCountOfSteps() { return maxCountOfSteps; }
+void    setMaxCountOfSteps(int count) { maxCountOfSteps = qMax(1, count); }
 
 bool fuzzyCompare(double a, double b) { return qAbs(a - b) <= EPSILON * 10; }
 bool fuzzyCompare(complex a, complex b) {
     return fuzzyCompare(a.real(), b.real()) && fuzzyCompare(a.imag(), b.imag());
 }
 
-void updateComplexLineEdit(QLineEdit *lineEdit) {
-    QRegExp re(QString::fromUtf8("[IШш]"));
-    lineEdit->setText(lineEdit->text().replace(re, "i"));
-}
-
 int random(int min, int max) { return min + rand() % ((max + 1) - min); }
 
 double random(double fMin, double fMax) {
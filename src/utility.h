@@ -18,8 +18,6 @@
 #define BLOCHUTILITY_H
 
 #include <QDebug>
-#include <QLineEdit>
-#include <QRegExpValidator>
 #include <QString>
 #include <complex>
 
@@ -27,8 +25,6 @@
 #define C_I complex(0, 1)
 #define M_PI 3.14159265358979323846
 #define DURATION 100.
-#define MAX_COUNT_SPHERES 5
-#define MAX_COUNT_OF_STEPS 100
 #define BLOCHSPHERE_VERSION "v1.1.0"
 #if QT_VERSION >= 0x050000
 #define BIT_VERSION "x64"
@@ -39,9 +35,6 @@
 typedef std::complex<double> complex;
 
 namespace Utility {
-const QValidator *compValid();
-const QValidator *axisValid();
-
 complex parseStrToComplex(const QString &str);
 QString parseComplexToStr(complex c, int d = 1 / EPSILON);
 bool    fuzzyCompare(double a, double b);
@@ -52,7 +45,11 @@ double  roundNumber(double a, double s = 1 / EPSILON);
 double  getDuration();
 double  getSpeed();
 void    setSpeed(int spd);
-void    updateComplexLineEdit(QLineEdit *lineEdit);
+// Limits of the spheres (circuit qubits) and circuit steps the window lets the user add
+int  getMaxCountOfSpheres();
+void setMaxCountOfSpheres(int count);
+int  getMaxCountOfSteps();
+void setMaxCountOfSteps(int count);
 
 int    random(int min, int max);
 double random(double fMin, double fMax);
@@ -15,45 +15,70 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Circuit.h"
-
-#include <QLabel>
+#include "CircuitDelegate.h"
+#include <QHeaderView>
+#include <QScrollBar>
+
+namespace {
+const int CELL_HEIGHT = 30;
+const int CELL_WIDTH = 100;
+const int BUTTONS_HEIGHT = 50;
+// More qubits scroll
+const int VISIBLE_QUBITS = 6;
+} // namespace
 
 Circuit::Circuit(QWidget *parent) : QWidget(parent) {
+    table = new CircuitTableModel(this);
+    table->resize(0, 1);
+
+    view = new QTableView(this);
+    view->setModel(table);
+    view->setItemDelegate(new CircuitDelegate(view));
+    view->setEditTriggers(QAbstractItemView::AllEditTriggers);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->horizontalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->horizontalHeader()->setDefaultSectionSize(CELL_WIDTH);
+    view->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    view->verticalHeader()->setDefaultSectionSize(CELL_HEIGHT);
+
     mainLayout = new QVBoxLayout(this);
-    qubitsLayout = new QVBoxLayout(mainLayout->widget());
-    mainLayout->addLayout(qubitsLayout);
+    mainLayout->addWidget(view);
     mainLayout->addWidget(makeButtons());
     mainLayout->setAlignment(Qt::AlignBottom);
     mainLayout->setSpacing(5);
     mainLayout->setMargin(0);
-    lenOfSteps = 1;
-    removeStepBut->setEnabled(lenOfSteps > 1);
+    removeStepBut->setEnabled(false);
+    updateHeight();
 }
 
 void Circuit::addQubit(Vector *v) {
-    foreach (auto e, qubits) {
-        if (v == e->getVector()) {
-            return;
-        }
+    if (vectors.contains(v)) {
+        return;
     }
-    auto qbt = new CircuitQubit(
-        this, v, CircuitQubit::getPsiHtml(QString::number(qubits.size() + 1)), lenOfSteps);
-    qubits.append(qbt);
-    this->setFixedHeight(50 + 35 * qubits.size());
-    qubitsLayout->addWidget(qbt);
+    vectors.append(v);
+    table->resize(vectors.size(), getSizeOfSteps());
+    updateHeight();
 }
 
 void Circuit::removeQubit() {
-    if (not qubits.empty()) {
-        mainLayout->removeWidget(qubits.last());
-        delete qubits.last();
-        qubits.pop_back();
-        this->setFixedHeight(50 + 35 * qubits.size());
+    if (not vectors.empty()) {
+        vectors.pop_back();
+        table->resize(vectors.size(), getSizeOfSteps());
+        updateHeight();
     }
 }
+
+void Circuit::updateHeight() {
+    int rows = qMin(vectors.size(), VISIBLE_QUBITS);
+    int height = view->horizontalHeader()->sizeHint().height() + rows * CELL_HEIGHT +
+                 view->horizontalScrollBar()->sizeHint().height() + 2 * view->frameWidth();
+    view->setFixedHeight(height);
+    this->setFixedHeight(BUTTONS_HEIGHT + height);
+}
+
 QWidget *Circuit::makeButtons() {
     auto wdt = new QWidget(this);
-    wdt->setFixedHeight(50);
+    wdt->setFixedHeight(BUTTONS_HEIGHT);
     auto layout = new QHBoxLayout(wdt);
     layout->setAlignment(Qt::AlignLeft);
 
@@ -73,22 +98,34 @@ QWidget *Circuit::makeButtons() {
     return wdt;
 }
 
-void Circuit::slotAddStep() {
-    lenOfSteps += 1;
-    foreach (auto e, qubits) { e->updateOperators(lenOfSteps); }
+void Circuit::setSizeOfSteps(int len) {
+    table->resize(vectors.size(), qBound(1, len, Utility::getMaxCountOfSteps()));
+    addStepBut->setEnabled(getSizeOfSteps() < Utility::getMaxCountOfSteps());
+    removeStepBut->setEnabled(getSizeOfSteps() > 1);
+}
 
-    addStepBut->setEnabled(lenOfSteps < MAX_COUNT_OF_STEPS);
-    removeStepBut->setEnabled(lenOfSteps > 1);
+void Circuit::setModel(const CircuitModel &model) {
+    CircuitModel circuit = model;
+    circuit.resize(vectors.size(), qBound(1, model.countOfSteps(), Utility::getMaxCountOfSteps()));
+    table->setCircuit(circuit);
+    addStepBut->setEnabled(getSizeOfSteps() < Utility::getMaxCountOfSteps());
+    removeStepBut->setEnabled(getSizeOfSteps() > 1);
 }
 
-void Circuit::slotRemoveStep() {
-    lenOfSteps -= 1;
-    foreach (auto e, qubits) { e->updateOperators(lenOfSteps); }
+void Circuit::showStep(int step) {
+    table->setActiveStep(step);
+    if (not vectors.isEmpty()) {
+        view->scrollTo(table->index(0, step));
+    }
+}
 
-    addStepBut->setEnabled(lenOfSteps < MAX_COUNT_OF_STEPS);
-    removeStepBut->setEnabled(lenOfSteps > 1);
+void Circuit::slotAddStep() {
+    setSizeOfSteps(getSizeOfSteps() + 1);
+    view->scrollTo(table->index(0, getSizeOfSteps() - 1));
 }
 
+void Circuit::slotRemoveStep() { setSizeOfSteps(getSizeOfSteps() - 1); }
+
 void Circuit::slotRun() {
     if (not isParentAnimating) {
         emit signalStartAnimation();
@@ -97,6 +134,4 @@ void Circuit::slotRun() {
 
 void Circuit::slotParentAnimating(bool f) { isParentAnimating = f; }
 
-void Circuit::slotStop() {
-    foreach (auto e, this->getQubits()) { e->resetState(); }
-}
+void Circuit::slotStop() { table->setActiveStep(-1); }
@@ -17,12 +17,15 @@
 #ifndef CIRCUIT_H
 #define CIRCUIT_H
 
-#include "CircuitQubit.h"
+#include "CircuitTableModel.h"
 #include "src/quantum/Vector.h"
 #include <QGridLayout>
 #include <QPushButton>
+#include <QTableView>
 #include <QWidget>
 
+// Circuit editor: a table view over the circuit model, which creates widgets for the visible
+// cells only, so long circuits cost no more than short ones
 class Circuit : public QWidget {
     Q_OBJECT
 public:
@@ -31,12 +34,18 @@ public:
     void addQubit(Vector *v);
     void removeQubit();
 
-    QWidget                       *makeButtons();
-    const QVector<CircuitQubit *> &getQubits() { return qubits; }
-    int                            getSizeOfSteps() { return lenOfSteps; }
-    void                           stepUp() { stepNumber += 1; }
-    void                           clearStepPos() { stepNumber = 0; }
-    int                            getCurrentStep() { return stepNumber; }
+    QWidget                 *makeButtons();
+    const QVector<Vector *> &getVectors() { return vectors; }
+    const CircuitModel      &getModel() { return table->getCircuit(); }
+    int                      getSizeOfSteps() { return getModel().countOfSteps(); }
+    void                     setSizeOfSteps(int len);
+    void                     stepUp() { stepNumber += 1; }
+    void                     clearStepPos() { stepNumber = 0; }
+    int                      getCurrentStep() { return stepNumber; }
+    // Marks the step as playing and scrolls it into view
+    void showStep(int step);
+    // Takes the cells of model, keeping the qubits of the circuit
+    void setModel(const CircuitModel &model);
 
     QPushButton *runCircuitBut = nullptr;
     QPushButton *addStepBut = nullptr;
@@ -53,12 +62,14 @@ public slots:
     void slotParentAnimating(bool f);
 
 private:
-    QVBoxLayout            *mainLayout = nullptr;
-    QVBoxLayout            *qubitsLayout = nullptr;
-    QVector<CircuitQubit *> qubits;
-    int                     lenOfSteps = 1;
-    int                     stepNumber = 0;
-    bool                    isParentAnimating = true;
+    QVBoxLayout       *mainLayout = nullptr;
+    QTableView        *view = nullptr;
+    CircuitTableModel *table = nullptr;
+    QVector<Vector *>  vectors;
+    int                stepNumber = 0;
+    bool               isParentAnimating = true;
+
+    void updateHeight();
 };
 
 #endif // CIRCUIT_H
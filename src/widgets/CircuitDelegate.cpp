@@ -0,0 +1,62 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CircuitDelegate.h"
+#include "BlochDialog.h"
+#include "CircuitTableModel.h"
+#include <QComboBox>
+
+CircuitDelegate::CircuitDelegate(QObject *parent) : QStyledItemDelegate(parent) {}
+
+QWidget *CircuitDelegate::createEditor(QWidget *parent, const QStyleOptionViewItem &,
+                                       const QModelIndex &) const {
+    auto editor = new QComboBox(parent);
+    for (int g = CircuitModel::ID; g < CircuitModel::COUNT; ++g) {
+        editor->addItem(CircuitModel::gateName(g));
+    }
+    connect(editor, SIGNAL(activated(int)), SLOT(slotGateActivated()));
+    return editor;
+}
+
+void CircuitDelegate::setEditorData(QWidget *editor, const QModelIndex &index) const {
+    static_cast<QComboBox *>(editor)->setCurrentIndex(index.data(Qt::EditRole).toInt());
+}
+
+void CircuitDelegate::setModelData(QWidget *editor, QAbstractItemModel *model,
+                                   const QModelIndex &index) const {
+    auto table = qobject_cast<CircuitTableModel *>(model);
+    if (table == nullptr) {
+        return;
+    }
+
+    circuitcell c;
+    c.gate = static_cast<quint8>(static_cast<QComboBox *>(editor)->currentIndex());
+    c.angle = 0;
+    if (CircuitModel::hasAngle(c.gate)) {
+        BlochDialog dialog(editor->window(), DIALOG_TYPE::ANGLE);
+        if (dialog.exec() != QDialog::Accepted) {
+            return;
+        }
+        c.angle = dialog.ang().toDouble() * M_PI / 180;
+    }
+    table->setCell(index.row(), index.column(), c);
+}
+
+void CircuitDelegate::slotGateActivated() {
+    auto editor = qobject_cast<QWidget *>(sender());
+    emit commitData(editor);
+    emit closeEditor(editor);
+}
@@ -0,0 +1,38 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CIRCUITDELEGATE_H
+#define CIRCUITDELEGATE_H
+
+#include <QStyledItemDelegate>
+
+// Edits a circuit cell with a gate menu; Phi and the rotations ask for their angle
+class CircuitDelegate : public QStyledItemDelegate {
+    Q_OBJECT
+public:
+    explicit CircuitDelegate(QObject *parent);
+
+    QWidget *createEditor(QWidget *parent, const QStyleOptionViewItem &option,
+                          const QModelIndex &index) const override;
+    void     setEditorData(QWidget *editor, const QModelIndex &index) const override;
+    void     setModelData(QWidget *editor, QAbstractItemModel *model,
+                          const QModelIndex &index) const override;
+
+private slots:
+    void slotGateActivated();
+};
+
+#endif // CIRCUITDELEGATE_H
@@ -1,49 +0,0 @@
-// A Bloch sphere emulator program.
-// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
-
-// This program is free software: you can redistribute it and/or modify
-// it under the terms of the GNU General Public License as published by
-// the Free Software Foundation, either version 3 of the License, or
-// (at your option) any later version.
-
-// This program is distributed in the hope that it will be useful,
-// but WITHOUT ANY WARRANTY; without even the implied warranty of
-// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
-// GNU General Public License for more details.
-
-// You should have received a copy of the GNU General Public License
-// along with this program.  If not, see <https://www.gnu.org/licenses/>.
-
-#ifndef CIRCUITQUBIT_H
-#define CIRCUITQUBIT_H
-
-#include "CircuitOperator.h"
-#include "src/quantum/Operator.h"
-#include "src/quantum/Vector.h"
-#include <QComboBox>
-#include <QHBoxLayout>
-#include <QWidget>
-
-class CircuitQubit : public QWidget {
-    Q_OBJECT
-public:
-    CircuitQubit(QWidget *parent, Vector *v, const QString &name, int cntOperators);
-    Vector        *getVector() { return _v; }
-    static QString getPsiHtml(QString index);
-    Operator      &getOperator(int ind);
-
-    void resetState();
-    void updateOperators(int len);
-    void printOperators();
-
-private:
-    QHBoxLayout               *mainLayout = nullptr;
-    Vector                    *_v;
-    QVector<CircuitOperator *> operators;
-    QString                    _name;
-    CircuitOperator           *lastOperator = nullptr;
-    int                        cellHigh = 30;
-    int                        cellWidth = 100;
-};
-
-#endif // CIRCUITQUBIT_H
@@ -0,0 +1,117 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "CircuitTableModel.h"
+#include <QFont>
+
+CircuitTableModel::CircuitTableModel(QObject *parent) : QAbstractTableModel(parent) {}
+
+int CircuitTableModel::rowCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : circuit.countOfQubits();
+}
+
+int CircuitTableModel::columnCount(const QModelIndex &parent) const {
+    return parent.isValid() ? 0 : circuit.countOfSteps();
+}
+
+QVariant CircuitTableModel::data(const QModelIndex &index, int role) const {
+    if (not index.isValid()) {
+        return QVariant();
+    }
+
+    circuitcell c = circuit.cell(index.row(), index.column());
+    if (role == Qt::DisplayRole) {
+        if (CircuitModel::hasAngle(c.gate)) {
+            return circuit.getOperator(index.row(), index.column()).getOperatorName();
+        }
+        return CircuitModel::gateName(c.gate);
+    } else if (role == Qt::EditRole) {
+        return c.gate;
+    } else if (role == Qt::FontRole and index.column() == activeStep) {
+        QFont font;
+        font.setBold(true);
+        return font;
+    } else if (role == Qt::TextAlignmentRole) {
+        return Qt::AlignCenter;
+    }
+    return QVariant();
+}
+
+QVariant CircuitTableModel::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QVariant();
+    }
+    if (orientation == Qt::Vertical) {
+        return QString::fromUtf8("ψ") + QString::number(section + 1);
+    }
+    return QString::number(section + 1);
+}
+
+Qt::ItemFlags CircuitTableModel::flags(const QModelIndex &index) const {
+    return QAbstractTableModel::flags(index) | Qt::ItemIsEditable;
+}
+
+void CircuitTableModel::setCell(int qubit, int step, circuitcell c) {
+    circuit.setCell(qubit, step, c);
+    emit dataChanged(index(qubit, step), index(qubit, step));
+}
+
+void CircuitTableModel::setCircuit(const CircuitModel &c) {
+    beginResetModel();
+    circuit = c;
+    activeStep = -1;
+    endResetModel();
+}
+
+void CircuitTableModel::resize(int countOfQubits, int countOfSteps) {
+    int qubits = circuit.countOfQubits();
+    int steps = circuit.countOfSteps();
+
+    if (countOfSteps > steps) {
+        beginInsertColumns(QModelIndex(), steps, countOfSteps - 1);
+        circuit.resize(qubits, countOfSteps);
+        endInsertColumns();
+    } else if (countOfSteps < steps) {
+        beginRemoveColumns(QModelIndex(), countOfSteps, steps - 1);
+        circuit.resize(qubits, countOfSteps);
+        endRemoveColumns();
+    }
+
+    if (countOfQubits > qubits) {
+        beginInsertRows(QModelIndex(), qubits, countOfQubits - 1);
+        circuit.resize(countOfQubits, countOfSteps);
+        endInsertRows();
+    } else if (countOfQubits < qubits) {
+        beginRemoveRows(QModelIndex(), countOfQubits, qubits - 1);
+        circuit.resize(countOfQubits, countOfSteps);
+        endRemoveRows();
+    }
+}
+
+void CircuitTableModel::setActiveStep(int step) {
+    int last = activeStep;
+    activeStep = step;
+    int rows = circuit.countOfQubits();
+    if (rows == 0) {
+        return;
+    }
+    if (last >= 0 and last < circuit.countOfSteps()) {
+        emit dataChanged(index(0, last), index(rows - 1, last), {Qt::FontRole});
+    }
+    if (step >= 0 and step < circuit.countOfSteps()) {
+        emit dataChanged(index(0, step), index(rows - 1, step), {Qt::FontRole});
+    }
+}
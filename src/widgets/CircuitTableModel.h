@@ -0,0 +1,49 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef CIRCUITTABLEMODEL_H
+#define CIRCUITTABLEMODEL_H
+
+#include "src/quantum/CircuitModel.h"
+#include <QAbstractTableModel>
+
+// Circuit as seen by the view: a row per qubit and a column per step
+class CircuitTableModel : public QAbstractTableModel {
+    Q_OBJECT
+public:
+    explicit CircuitTableModel(QObject *parent);
+
+    int           rowCount(const QModelIndex &parent = QModelIndex()) const override;
+    int           columnCount(const QModelIndex &parent = QModelIndex()) const override;
+    QVariant      data(const QModelIndex &index, int role = Qt::DisplayRole) const override;
+    QVariant      headerData(int section, Qt::Orientation orientation,
+                             int role = Qt::DisplayRole) const override;
+    Qt::ItemFlags flags(const QModelIndex &index) const override;
+
+    const CircuitModel &getCircuit() const { return circuit; }
+    void                setCell(int qubit, int step, circuitcell c);
+    void                resize(int countOfQubits, int countOfSteps);
+    // Replaces the whole circuit at once, e.g. when a session is opened
+    void setCircuit(const CircuitModel &c);
+    // The step is shown in bold; -1 for none
+    void setActiveStep(int step);
+
+private:
+    CircuitModel circuit;
+    int          activeStep = -1;
+};
+
+#endif // CIRCUITTABLEMODEL_H
@@ -0,0 +1,88 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "FrameExport.h"
+
+bool FrameExport::capture(int width, int height) {
+    if (frame == 0) {
+        size = QSize(width, height);
+    } else if (size != QSize(width, height)) {
+        // A stream keeps the size of its first frame
+        error = "the frame size changed";
+        return false;
+    }
+
+    if (not read(frame % 2)) {
+        return false;
+    }
+    ++frame;
+    return frame < 2 or deliver(frame - 2);
+}
+
+bool FrameExport::finish() {
+    bool isDelivered = frame == 0 or deliver(frame - 1);
+    for (QOpenGLBuffer &buffer : buffers) {
+        buffer.destroy();
+    }
+    return isDelivered;
+}
+
+// Starts copying the back buffer into buffers[index]; with a pack buffer bound glReadPixels
+// does not wait for the frame
+bool FrameExport::read(int index) {
+    QOpenGLBuffer &buffer = buffers[index];
+    int            bytes = size.width() * size.height() * 4;
+    if (not buffer.isCreated()) {
+        if (not buffer.create()) {
+            error = "no pixel buffer objects";
+            return false;
+        }
+        buffer.setUsagePattern(QOpenGLBuffer::StreamRead);
+        buffer.bind();
+        buffer.allocate(bytes);
+    } else {
+        buffer.bind();
+    }
+
+    glReadBuffer(GL_BACK);
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, size.width(), size.height(), GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    buffer.release();
+    return true;
+}
+
+bool FrameExport::deliver(int number) {
+    QOpenGLBuffer &buffer = buffers[number % 2];
+    buffer.bind();
+    auto *pixels = static_cast<const uchar *>(buffer.map(QOpenGLBuffer::ReadOnly));
+    if (pixels == nullptr) {
+        buffer.release();
+        error = "cannot map a pixel buffer object";
+        return false;
+    }
+    // GL rows go upwards; mirrored() copies the frame out of the buffer
+    QImage image = QImage(pixels, size.width(), size.height(), size.width() * 4,
+                          QImage::Format_RGBA8888)
+                       .mirrored();
+    buffer.unmap();
+    buffer.release();
+    if (not sink->put(number, image)) {
+        error = sink->errorString();
+        return false;
+    }
+    return true;
+}
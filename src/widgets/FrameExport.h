@@ -0,0 +1,56 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef FRAMEEXPORT_HPP
+#define FRAMEEXPORT_HPP
+
+#include "FrameSink.h"
+#include <QGLWidget>
+#include <QOpenGLBuffer>
+
+// Hands the frames a Sphere paints to a FrameSink as they are made. Each frame is read into one
+// of two pixel buffer objects, which returns at once; it is mapped and passed on after the next
+// frame has been painted, when the GPU has long copied it, so that readback overlaps rendering.
+// Memory stays at two frames on the GPU and one in the sink however long the export.
+class FrameExport {
+public:
+    // The sink stays the caller's
+    explicit FrameExport(FrameSink *sink) : sink(sink) {}
+
+    // All need the GL context to be current. capture() reads the back buffer, so it comes after
+    // painting and before the swap.
+    bool capture(int width, int height);
+    // Passes on the last frame and frees the buffers
+    bool finish();
+
+    int     countOfFrames() const { return frame; }
+    QString errorString() const { return error; }
+
+private:
+    FrameSink    *sink;
+    QOpenGLBuffer buffers[2] = {QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer),
+                                QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer)};
+    QSize         size;
+    QString       error;
+    // Frames read so far; frame - 1 waits in buffers[(frame - 1) % 2]
+    int frame = 0;
+
+    bool read(int index);
+    bool deliver(int number);
+};
+
+#endif // FRAMEEXPORT_HPP
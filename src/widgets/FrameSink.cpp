@@ -0,0 +1,132 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "FrameSink.h"
+#include <QMutexLocker>
+
+namespace {
+// Bytes a device such as a QProcess may hold before writing waits for it
+const qint64 MAX_BUFFERED = 4 << 20;
+} // namespace
+
+QString FrameSink::errorString() const {
+    QMutexLocker locker(&mutex);
+    return error;
+}
+
+bool PngFrameSink::put(int frame, const QImage &image) {
+    QString fileName = pattern.arg(frame, 6, 10, QChar('0'));
+    if (image.save(fileName, "PNG")) {
+        return true;
+    }
+    QMutexLocker locker(&mutex);
+    error = "cannot write " + fileName;
+    return false;
+}
+
+bool StreamFrameSink::put(int frame, const QImage &image) {
+    QMutexLocker locker(&mutex);
+    while (not failed and frame >= next + capacity) {
+        ready.wait(&mutex);
+    }
+    if (failed) {
+        return false;
+    }
+
+    pending.insert(frame, image);
+    while (not failed and not pending.isEmpty() and pending.firstKey() == next) {
+        failed = not writeFrame(pending.take(next));
+        ++next;
+    }
+    ready.wakeAll();
+    return not failed;
+}
+
+bool StreamFrameSink::finish() {
+    QMutexLocker locker(&mutex);
+    if (not failed and not pending.isEmpty()) {
+        error = QString("frame %1 is missing").arg(next);
+        failed = true;
+    }
+    // A pipe may still hold the last frames
+    while (not failed and device->bytesToWrite() > 0) {
+        if (not device->waitForBytesWritten(-1)) {
+            break;
+        }
+    }
+    return not failed;
+}
+
+bool StreamFrameSink::write(const char *data, qint64 size) {
+    if (device->write(data, size) != size) {
+        error = device->errorString();
+        return false;
+    }
+    while (device->bytesToWrite() > MAX_BUFFERED) {
+        if (not device->waitForBytesWritten(-1)) {
+            error = device->errorString();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool RawFrameSink::writeFrame(const QImage &image) {
+    QImage rgba = image.convertToFormat(QImage::Format_RGBA8888);
+    for (int y = 0; y < rgba.height(); ++y) {
+        if (not write(reinterpret_cast<const char *>(rgba.constScanLine(y)), rgba.width() * 4)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// BT.601 in the studio range that YUV4MPEG2 assumes
+bool Y4mFrameSink::writeFrame(const QImage &image) {
+    if (size.isEmpty()) {
+        size = image.size();
+        QByteArray header = QString("YUV4MPEG2 W%1 H%2 F%3:1 Ip A1:1 C444\n")
+                                .arg(size.width())
+                                .arg(size.height())
+                                .arg(framesPerSecond)
+                                .toLatin1();
+        if (not write(header.constData(), header.size())) {
+            return false;
+        }
+        planes.resize(size.width() * size.height() * 3);
+    }
+    if (image.size() != size) {
+        error = "the frame size changed";
+        return false;
+    }
+
+    QImage rgba = image.convertToFormat(QImage::Format_RGBA8888);
+    int    area = size.width() * size.height();
+    uchar *y = reinterpret_cast<uchar *>(planes.data());
+    uchar *u = y + area;
+    uchar *v = u + area;
+    for (int row = 0; row < size.height(); ++row) {
+        const uchar *pixel = rgba.constScanLine(row);
+        for (int column = 0; column < size.width(); ++column, pixel += 4) {
+            int r = pixel[0], g = pixel[1], b = pixel[2];
+            *y++ = static_cast<uchar>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+            *u++ = static_cast<uchar>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+            *v++ = static_cast<uchar>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+        }
+    }
+    return write("FRAME\n", 6) and write(planes.constData(), planes.size());
+}
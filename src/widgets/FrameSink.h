@@ -0,0 +1,107 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef FRAMESINK_HPP
+#define FRAMESINK_HPP
+
+#include <QByteArray>
+#include <QIODevice>
+#include <QImage>
+#include <QMap>
+#include <QMutex>
+#include <QWaitCondition>
+
+// Where rendered frames go. put() may be called from several threads at once and in any order of
+// the frame numbers.
+class FrameSink {
+public:
+    virtual ~FrameSink() = default;
+
+    // False once writing failed, with the reason in errorString()
+    virtual bool put(int frame, const QImage &image) = 0;
+    // False when frames are missing or could not be written
+    virtual bool finish() { return true; }
+
+    QString errorString() const;
+
+protected:
+    mutable QMutex mutex;
+    QString        error;
+};
+
+// A PNG file per frame, named by a pattern with %1 for the frame number
+class PngFrameSink : public FrameSink {
+public:
+    explicit PngFrameSink(const QString &pattern) : pattern(pattern) {}
+
+    bool put(int frame, const QImage &image) override;
+
+private:
+    const QString pattern;
+};
+
+// Frames written one after another in the order of their numbers, into a file or a pipe to an
+// encoder. Frames that come early wait for the ones before them, at most capacity of them, and a
+// device that buffers, such as a QProcess, is drained as it goes, so that memory stays bounded
+// however long the stream.
+class StreamFrameSink : public FrameSink {
+public:
+    StreamFrameSink(QIODevice *device, int capacity) : device(device), capacity(capacity) {}
+
+    bool put(int frame, const QImage &image) override;
+    bool finish() override;
+
+protected:
+    // Called in the order of the frames, with the mutex locked
+    virtual bool writeFrame(const QImage &image) = 0;
+    bool         write(const char *data, qint64 size);
+
+private:
+    QIODevice        *device;
+    const int         capacity;
+    int               next = 0;
+    QMap<int, QImage> pending;
+    QWaitCondition    ready;
+    bool              failed = false;
+};
+
+// Raw RGBA, e.g. for ffmpeg -f rawvideo -pix_fmt rgba
+class RawFrameSink : public StreamFrameSink {
+public:
+    using StreamFrameSink::StreamFrameSink;
+
+protected:
+    bool writeFrame(const QImage &image) override;
+};
+
+// YUV4MPEG2 with full chroma, which encoders read without being told the size or the rate
+class Y4mFrameSink : public StreamFrameSink {
+public:
+    Y4mFrameSink(QIODevice *device, int capacity, int framesPerSecond)
+        : StreamFrameSink(device, capacity), framesPerSecond(framesPerSecond) {}
+
+protected:
+    bool writeFrame(const QImage &image) override;
+
+private:
+    const int framesPerSecond;
+    QSize     size;
+    // Y, U and V planes of a frame, reused from frame to frame
+    QByteArray planes;
+};
+
+#endif // FRAMESINK_HPP
@@ -0,0 +1,69 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Instrumentation.h"
+#include <QtGlobal>
+
+namespace {
+bool          enabled = false;
+QElapsedTimer tickClock;
+Measure       jitter;
+int           droppedFrames = 0;
+} // namespace
+
+void Measure::add(double ms) {
+    last_ = ms;
+    sum_ += ms;
+    max_ = qMax(max_, ms);
+    ++count_;
+}
+
+QJsonObject Measure::toJson() const {
+    QJsonObject json;
+    json["lastMs"] = last();
+    json["averageMs"] = average();
+    json["maxMs"] = max();
+    json["count"] = count();
+    return json;
+}
+
+namespace Instrumentation {
+bool isEnabled() { return enabled; }
+void setEnabled(bool f) {
+    enabled = f;
+    resetTicks();
+}
+
+void tick(double targetMs) {
+    if (not enabled) {
+        return;
+    }
+    if (tickClock.isValid()) {
+        double interval = tickClock.nsecsElapsed() / 1e6;
+        jitter.add(qAbs(interval - targetMs));
+        // Refreshes the animation missed
+        droppedFrames += qMax(0, static_cast<int>(interval / targetMs) - 1);
+    }
+    tickClock.start();
+}
+
+void resetTicks() { tickClock.invalidate(); }
+
+const Measure &getJitter() { return jitter; }
+int            getDroppedFrames() { return droppedFrames; }
+
+QString getDumpFileName() { return qEnvironmentVariable("BLOCHSPHERE_STATS"); }
+} // namespace Instrumentation
@@ -0,0 +1,60 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef INSTRUMENTATION_HPP
+#define INSTRUMENTATION_HPP
+
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QString>
+
+// Running statistics of a duration in milliseconds
+class Measure {
+public:
+    void add(double ms);
+    void reset() { *this = Measure(); }
+
+    double last() const { return last_; }
+    double average() const { return count_ == 0 ? 0. : sum_ / count_; }
+    double max() const { return max_; }
+    int    count() const { return count_; }
+
+    QJsonObject toJson() const;
+
+private:
+    double last_ = 0.;
+    double sum_ = 0.;
+    double max_ = 0.;
+    int    count_ = 0;
+};
+
+// Timing of the animation clock and on-sphere statistics. Disabled by default, so the
+// measurements cost nothing unless the user asks for them.
+namespace Instrumentation {
+bool isEnabled();
+void setEnabled(bool f);
+
+// Called on every animation step with the interval the steps are expected at
+void           tick(double targetMs);
+void           resetTicks();
+const Measure &getJitter();
+int            getDroppedFrames();
+
+// Statistics are dumped here at the end of every animation when set through BLOCHSPHERE_STATS
+QString getDumpFileName();
+} // namespace Instrumentation
+
+#endif // INSTRUMENTATION_HPP
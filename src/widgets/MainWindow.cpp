@@ -16,23 +16,46 @@
 
 #include "MainWindow.h"
 #include "BlochDialog.h"
+#include "FrameSink.h"
 #include "src/quantum/Operator.h"
+#include "src/quantum/Session.h"
+#include "src/quantum/StateVector.h"
 #include <QCheckBox>
+#include <QFile>
+#include <QFileDialog>
+#include <QFileInfo>
 #include <QGridLayout>
 #include <QGroupBox>
+#include <QGuiApplication>
+#include <QJsonArray>
+#include <QJsonDocument>
 #include <QLineEdit>
 #include <QMenuBar>
 #include <QMessageBox>
+#include <QProcess>
 #include <QPushButton>
+#include <QScreen>
 #include <QScrollArea>
 #include <QScrollBar>
 #include <QStatusBar>
 #include <QString>
+#include <QTextStream>
 #include <QTime>
 #include <QTimer>
 #include <QToolBar>
 #include <cassert>
 
+namespace {
+// Paths have one frame per this many milliseconds at any refresh rate
+const double FRAME_INTERVAL = 10.;
+// Spheres that swap within this part of a frame of each other share one animation step
+const double MIN_STEP = 0.1;
+// Watchdog interval in milliseconds
+const int STALL_INTERVAL = 100;
+// The vector fields are refreshed at most this often while animating, in milliseconds
+const int FIELDS_INTERVAL = 1000 / 15;
+} // namespace
+
 MainWindow::MainWindow(QWidget *parent) : QMainWindow{parent} {
     createSphere();
     createActions();
@@ -44,6 +67,10 @@ MainWindow::MainWindow(QWidget *parent) : QMainWindow{parent} {
     tm = new QTimer(this);
     connect(tm, SIGNAL(timeout()), SLOT(slotTimer()));
     statusBar()->show();
+
+    if (not Instrumentation::getDumpFileName().isEmpty()) {
+        showStatAct->setChecked(true);
+    }
 }
 
 void MainWindow::addVector(Vector *v, MapVectors &mp) {
@@ -78,21 +105,41 @@ void MainWindow::removeAllVectors(MapVectors &mp) {
 }
 
 void MainWindow::slotTimer() {
-    bool isNowAnimate = false;
-    foreach (auto e, topTabWid->findChildren<VectorWidget *>()) {
-        isNowAnimate |= e->getVector()->isNowAnimate();
-        if (e->getVector() != nullptr) {
-            if (e->getVector()->isNowAnimate()) {
-                e->getVector()->takeStep();
-            }
-            e->fillFieldsOfVector(e->getVector()->getSpike());
+    if (not tm->isActive()) {
+        return;
+    }
+    double frames = frameClock.nsecsElapsed() / 1e6 / FRAME_INTERVAL;
+    if (frames < MIN_STEP) {
+        return;
+    }
+    frameClock.start();
+    tm->start(STALL_INTERVAL);
+    Instrumentation::tick(1000. / QGuiApplication::primaryScreen()->refreshRate());
+
+    // A vector still counts on the step that finds its path finished
+    bool isNowAnimate = not animatingVectors.isEmpty();
+    for (int i = 0; i < animatingVectors.size();) {
+        Vector *v = animatingVectors[i];
+        v->advance(frames);
+        if (v->isNowAnimate()) {
+            ++i;
+        } else {
+            animatingVectors.remove(i);
         }
     }
 
+    if (fieldsClock.hasExpired(FIELDS_INTERVAL)) {
+        slotRefreshVisibleFields();
+    }
+
     if (not isNowAnimate) {
         if (isQueueAnimation) {
-            opQueue.last()->setBackground(QBrush(Qt::white));
-            opQueue.pop_back();
+            // A fused queue is done after one operator
+            int done = isFusedQueue ? opQueue.size() : 1;
+            for (int k = 0; k < done; ++k) {
+                opQueue.last()->setBackground(QBrush(Qt::white));
+                opQueue.pop_back();
+            }
             if (not opQueue.isEmpty()) {
                 opQueue.last()->setBackground(QBrush(Qt::red));
                 curOperator = opQueue.last()->getOp();
@@ -100,7 +147,7 @@ void MainWindow::slotTimer() {
                 slotApplyOp();
                 isQueueAnimation = true;
             } else {
-                stopTimer();
+                finishAnimation();
                 curOperator = singleOperator;
             }
         } else if (isCircuitAnimation) {
@@ -109,19 +156,30 @@ void MainWindow::slotTimer() {
                 isCircuitAnimation = false;
                 vectorangle va = curOperator.vectorAngleDec();
                 foreach (auto e, vectors.keys()) {
-                    e->setRotateVector(QVector3D(va.x, va.y, va.z));
+                    e->setRotateVector(Vector3D(va.x, va.y, va.z));
                 }
                 circuit->slotStop();
-                stopTimer();
+                finishAnimation();
             } else {
                 nextAnimStepCircuit();
             }
         } else {
-            stopTimer();
+            finishAnimation();
         }
     }
 
-    slotUpdateSpheres();
+    // Without a sphere to swap a frame, the next step comes from the timer
+    if (not updateDirtySpheres() and tm->isActive()) {
+        tm->start(static_cast<int>(FRAME_INTERVAL));
+    }
+}
+
+void MainWindow::connectSphere(Sphere *sphere) {
+    if (sphere->isClock()) {
+        connect(sphere, SIGNAL(signalFrameSwapped()), SLOT(slotTimer()));
+    }
+    // Stops after the paint that failed
+    connect(sphere, SIGNAL(signalExportFailed()), SLOT(slotStopExport()), Qt::QueuedConnection);
 }
 
 void MainWindow::createSphere() {
@@ -134,8 +192,9 @@ void MainWindow::createSphere() {
 
     for (int i = 0; i < 1; ++i) {
         for (int j = 1; j < 2; ++j) {
-            spheres.append(new Sphere(controlWidget));
+            spheres.append(new Sphere(controlWidget, spheres.isEmpty()));
             sphereLayout->addWidget(spheres.last());
+            connectSphere(spheres.last());
         }
     }
     circuit = new Circuit(this);
@@ -164,6 +223,27 @@ void MainWindow::createActions() {
     clearTAct = new QAction("Clear trace", this);
     connect(clearTAct, SIGNAL(triggered()), SLOT(slotClearTrace()));
 
+    showStatAct = new QAction("Show statistics", this);
+    showStatAct->setCheckable(true);
+    connect(showStatAct, SIGNAL(toggled(bool)), SLOT(slotShowStatistics(bool)));
+
+    saveStatAct = new QAction("Save statistics...", this);
+    connect(saveStatAct, SIGNAL(triggered()), SLOT(slotSaveStatistics()));
+
+    openSessAct = new QAction("Open session...", this);
+    connect(openSessAct, SIGNAL(triggered()), SLOT(slotOpenSession()));
+    saveSessAct = new QAction("Save session...", this);
+    connect(saveSessAct, SIGNAL(triggered()), SLOT(slotSaveSession()));
+
+    exportAct = new QAction("Export video...", this);
+    exportAct->setCheckable(true);
+    connect(exportAct, SIGNAL(toggled(bool)), SLOT(slotExportVideo(bool)));
+
+    fastEngAct = new QAction("Fast decompositions", this);
+    fastEngAct->setCheckable(true);
+    fastEngAct->setChecked(DecompositionKernel::getEngine() == DecompositionKernel::FAST);
+    connect(fastEngAct, SIGNAL(toggled(bool)), SLOT(slotFastDecompositions(bool)));
+
     exitAct = new QAction("Exit", this);
     connect(exitAct, SIGNAL(triggered()), SLOT(close()));
 }
@@ -175,13 +255,22 @@ void MainWindow::createMenu() {
 
     auto mnuBar = new QMenuBar(this);
     auto menuFile = new QMenu("File", mnuBar);
+    auto menuSettings = new QMenu("Settings", mnuBar);
     auto menuInfo = new QMenu("Info", mnuBar);
 
+    menuFile->addAction(openSessAct);
+    menuFile->addAction(saveSessAct);
+    menuFile->addAction(exportAct);
     menuFile->addSeparator();
     menuFile->addAction(exitAct);
+    menuSettings->addAction(fastEngAct);
+    menuInfo->addAction(showStatAct);
+    menuInfo->addAction(saveStatAct);
+    menuInfo->addSeparator();
     menuInfo->addAction(aboutAct);
 
     mnuBar->addMenu(menuFile);
+    mnuBar->addMenu(menuSettings);
     mnuBar->addMenu(menuInfo);
 
     this->setMenuBar(mnuBar);
@@ -274,11 +363,14 @@ void MainWindow::createOpQueWidget() {
     clrQueBut = new QPushButton("Clear queue", opQueWid);
     clrQueBut->setFixedSize(70, 40);
     connect(clrQueBut, SIGNAL(clicked()), opQueWid, SLOT(clear()));
+    fuseQueBox = new QCheckBox("Fuse", opQueWid);
+    fuseQueBox->setToolTip("Apply the queue as one operator, the product of its operators");
 
     auto qtb = new QToolBar("Operators queue", this);
     qtb->addWidget(opQueWid);
     qtb->addWidget(appQueBut);
     qtb->addWidget(clrQueBut);
+    qtb->addWidget(fuseQueBox);
     qtb->setAllowedAreas(Qt::BottomToolBarArea | Qt::TopToolBarArea);
     qtb->setFixedHeight(41);
     this->addToolBar(Qt::BottomToolBarArea, qtb);
@@ -318,6 +410,8 @@ void MainWindow::createSideWidget() {
     circuit->addQubit(vct);
 
     topTabWid->addTab(vectorWidget, "1");
+    vectorWidgets.append(vectorWidget);
+    connect(topTabWid, SIGNAL(currentChanged(int)), SLOT(slotRefreshVisibleFields()));
     mainLay->addWidget(vectorSphereCreatorWid);
     mainLay->addWidget(topTabWid);
     mainLay->addWidget(makeDecompWid());
@@ -653,25 +747,25 @@ void MainWindow::slotClearTrace() {
 }
 
 void MainWindow::slotTraceColor(int index) {
-    QColor clr;
+    rgb clr;
     switch (index) {
     case 0:
-        clr = QColor(Qt::red);
+        clr = Color::RED;
         break;
     case 1:
-        clr = QColor(Qt::green);
+        clr = Color::GREEN;
         break;
     case 2:
-        clr = QColor(Qt::blue);
+        clr = Color::BLUE;
         break;
     case 3:
-        clr = QColor(Qt::gray);
+        clr = Color::GRAY;
         break;
     case 4:
-        clr = QColor(Qt::yellow);
+        clr = Color::YELLOW;
         break;
     default:
-        clr = QColor(Qt::black);
+        clr = Color::BLACK;
     }
     foreach (auto &e, vectors.keys()) { e->setTraceColor(clr); }
 }
@@ -868,7 +962,7 @@ void MainWindow::updateOp(OPERATOR_FORM exclude) {
     }
 
     vectorangle va = curOperator.vectorAngleDec();
-    foreach (auto e, vectors.keys()) { e->setRotateVector(QVector3D(va.x, va.y, va.z)); }
+    foreach (auto e, vectors.keys()) { e->setRotateVector(Vector3D(va.x, va.y, va.z)); }
 
     if (exclude != OPERATOR_FORM::VECTOR) {
         axRnEd->setText(QString("%1;%2;%3")
@@ -909,7 +1003,22 @@ void MainWindow::slotApplyQue() {
         opQueue.append((OpItem *)(opQueWid->item(i)));
     }
 
-    if (not opQueue.isEmpty()) {
+    isFusedQueue = fuseQueBox->isChecked() and opQueue.size() > 1;
+    if (isFusedQueue) {
+        // The queue plays from its last item to its first
+        QVector<Operator> ops;
+        for (int i = opQueue.size() - 1; i >= 0; --i) {
+            ops.append(opQueue[i]->getOp());
+            opQueue[i]->setBackground(QBrush(Qt::red));
+        }
+        curOperator = Operator::fuse(ops);
+        statusBar()->showMessage(QString("Fused %1 operators into %2")
+                                     .arg(ops.size())
+                                     .arg(curOperator.getOperatorName()));
+        updateOp();
+        slotApplyOp();
+        isQueueAnimation = true;
+    } else if (not opQueue.isEmpty()) {
         curOperator = opQueue.last()->getOp();
         opQueue.last()->setBackground(QBrush(Qt::red));
         updateOp();
@@ -922,15 +1031,21 @@ void MainWindow::startMove(Vector *v, CurDecompFun getDec) {
     v->changeVector((curOperator.*getDec)(v->getSpike()));
     v->setOperator(curOperator.getOperatorName());
     v->setAnimateState(true);
+    if (not animatingVectors.contains(v)) {
+        animatingVectors.append(v);
+    }
     startTimer();
 }
 
-void MainWindow::startMove(Vector *v, Operator &op, CurDecompFun getDec) {
+void MainWindow::startMove(Vector *v, Operator &op, const Path &path) {
     vectorangle va = op.vectorAngleDec();
-    v->setRotateVector(QVector3D(va.x, va.y, va.z));
+    v->setRotateVector(Vector3D(va.x, va.y, va.z));
     v->setOperator(op.getOperatorName());
-    v->changeVector((op.*getDec)(v->getSpike()));
+    v->changeVector(path);
     v->setAnimateState(true);
+    if (not animatingVectors.contains(v)) {
+        animatingVectors.append(v);
+    }
     startTimer();
 }
 
@@ -938,9 +1053,13 @@ void MainWindow::nextAnimStepCircuit() {
     stopTimer();
     isCircuitAnimation = true;
 
-    foreach (auto e, circuit->getQubits()) {
-        startMove(e->getVector(), e->getOperator(circuit->getCurrentStep()),
-                  getCurrentDecomposition());
+    // Planned while the previous step animated
+    circuitstep              step = circuitPlanner.takeStep(getCurrentDecomposition());
+    const QVector<Vector *> &qubits = circuit->getVectors();
+    circuit->showStep(circuit->getCurrentStep());
+
+    for (int k = 0; k < qubits.size() and k < step.paths.size(); ++k) {
+        startMove(qubits[k], step.operators[k], step.paths[k]);
     }
 }
 
@@ -986,7 +1105,9 @@ void MainWindow::slotAbout() {
 }
 
 void MainWindow::slotReset() {
-    stopTimer();
+    finishAnimation();
+    // The exporting sphere goes away with the others
+    slotStopExport();
     controlWidget->hide();
     while (not spheres.empty()) {
         foreach (auto e, vectors.keys()) {
@@ -997,24 +1118,23 @@ void MainWindow::slotReset() {
         spheres.last()->~Sphere();
         spheres.pop_back();
 
+        vectorWidgets.removeLast();
         delete topTabWid->widget(spheres.size());
         topTabWid->removeTab(spheres.size());
         circuit->removeQubit();
     }
 
-    while (circuit->getSizeOfSteps() != 1) {
-        circuit->slotRemoveStep();
-    }
+    circuit->setSizeOfSteps(1);
 
     controlWidget->show();
     slotPlusSphere();
 }
 
 void MainWindow::slotClear() {
-    stopTimer();
+    finishAnimation();
 
     Vector v(0., 0.);
-    foreach (auto e, topTabWid->findChildren<VectorWidget *>()) {
+    foreach (auto e, vectorWidgets) {
         if (e->getVector() != nullptr) {
             e->getVector()->changeVector(v.getSpike());
             e->fillFieldsOfVector(e->getVector()->getSpike());
@@ -1039,15 +1159,14 @@ void MainWindow::slotToggleRotateVector(bool f) {
 
 void MainWindow::slotToggleAutoNormalize(bool f) {
     isAutoNormalize = f;
-    foreach (auto e, topTabWid->findChildren<VectorWidget *>()) {
-        e->setAutoNormalise(isAutoNormalize);
-    }
+    foreach (auto e, vectorWidgets) { e->setAutoNormalise(isAutoNormalize); }
 }
 
 void MainWindow::slotPlusSphere() {
-    if (spheres.size() < MAX_COUNT_SPHERES) {
-        spheres.append(new Sphere(controlWidget));
+    if (spheres.size() < maxCountOfSpheres()) {
+        spheres.append(new Sphere(controlWidget, spheres.isEmpty()));
         sphereLayout->addWidget(spheres.last());
+        connectSphere(spheres.last());
 
         auto vct = new Vector(0., 0.);
         addVector(vct, vectors, spheres.last());
@@ -1057,17 +1176,22 @@ void MainWindow::slotPlusSphere() {
         auto vectorWidget = new VectorWidget(topTabWid, vct);
         connect(vectorWidget, SIGNAL(signalUpdate()), this, SLOT(slotUpdateSpheres()));
         topTabWid->addTab(vectorWidget, QString::number(spheres.size()));
+        vectorWidgets.append(vectorWidget);
         circuit->addQubit(vct);
 
         vectorangle va = curOperator.vectorAngleDec();
-        vct->setRotateVector(QVector3D(va.x, va.y, va.z));
+        vct->setRotateVector(Vector3D(va.x, va.y, va.z));
         vct->setEnabledRotateVector(rtRb->isChecked());
     }
 
-    spherePlusBut->setEnabled(spheres.size() < MAX_COUNT_SPHERES);
+    spherePlusBut->setEnabled(spheres.size() < maxCountOfSpheres());
     sphereMinusBut->setEnabled(spheres.size() > 1);
 }
 
+int MainWindow::maxCountOfSpheres() {
+    return qMin(Utility::getMaxCountOfSpheres(), StateVector::MAX_QUBITS);
+}
+
 void MainWindow::slotMinusSphere() {
     if (not spheres.empty()) {
         foreach (auto e, vectors.keys()) {
@@ -1078,25 +1202,35 @@ void MainWindow::slotMinusSphere() {
         spheres.last()->~Sphere();
         spheres.pop_back();
 
+        vectorWidgets.removeLast();
         delete topTabWid->widget(spheres.size());
         topTabWid->removeTab(spheres.size());
         circuit->removeQubit();
     }
 
-    spherePlusBut->setEnabled(spheres.size() < MAX_COUNT_SPHERES);
+    spherePlusBut->setEnabled(spheres.size() < maxCountOfSpheres());
     sphereMinusBut->setEnabled(spheres.size() > 1);
 }
 
 void MainWindow::startTimer() {
     if (not tm->isActive()) {
-        tm->start(10);
+        tm->start(STALL_INTERVAL);
+        frameClock.start();
+        fieldsClock.start();
         emit signalAnimating(true);
+        // The first swapped frame takes the first step
+        if (not updateDirtySpheres()) {
+            tm->start(static_cast<int>(FRAME_INTERVAL));
+        }
     }
     setEnabledWidgets(false);
 }
 
 void MainWindow::stopTimer() {
     tm->stop();
+    foreach (auto e, animatingVectors) { e->setAnimateState(false); }
+    animatingVectors.clear();
+    foreach (auto e, vectorWidgets) { e->refreshFields(); }
     isCircuitAnimation = false;
     isQueueAnimation = false;
     foreach (auto e, vectors.keys()) { e->setOperator(""); }
@@ -1105,26 +1239,352 @@ void MainWindow::stopTimer() {
     slotUpdateSpheres();
 }
 
+void MainWindow::finishAnimation() {
+    bool isAnimating = tm->isActive();
+    stopTimer();
+    // Idle time until the next animation is no dropped frame
+    Instrumentation::resetTicks();
+    if (isAnimating and not Instrumentation::getDumpFileName().isEmpty()) {
+        writeStatistics(Instrumentation::getDumpFileName());
+    }
+}
+
 void MainWindow::setEnabledWidgets(bool f) {
     appBut->setEnabled(f);
+    openSessAct->setEnabled(f);
     appQueBut->setEnabled(f);
-    spherePlusBut->setEnabled(f and spheres.size() < MAX_COUNT_SPHERES);
+    spherePlusBut->setEnabled(f and spheres.size() < maxCountOfSpheres());
     sphereMinusBut->setEnabled(f and spheres.size() > 1);
     circuit->runCircuitBut->setEnabled(f);
-    circuit->addStepBut->setEnabled(f and circuit->getSizeOfSteps() < MAX_COUNT_OF_STEPS);
+    circuit->addStepBut->setEnabled(f and
+                                    circuit->getSizeOfSteps() < Utility::getMaxCountOfSteps());
     circuit->removeStepBut->setEnabled(f and circuit->getSizeOfSteps() > 1);
     clrQueBut->setEnabled(f);
 }
 
 void MainWindow::slotStartCircuitMove() {
+    const CircuitModel &model = circuit->getModel();
+    if (model.hasControls() and model.countOfQubits() > CircuitState::MAX_JOINT_QUBITS) {
+        QMessageBox::warning(this, "Run circuit",
+                             QString("A circuit with Ctrl gates runs on at most %1 qubits")
+                                 .arg(CircuitState::MAX_JOINT_QUBITS));
+        return;
+    }
     circuit->clearStepPos();
+    QVector<Spike> spikes;
+    foreach (auto e, circuit->getVectors()) { spikes.append(e->getSpike()); }
+    circuitPlanner.start(circuit->getModel(), spikes, getCurrentDecomposition());
     nextAnimStepCircuit();
 }
 
-void MainWindow::slotUpdateSpheres() {
+void MainWindow::slotShowStatistics(bool f) {
+    Instrumentation::setEnabled(f);
     foreach (auto e, spheres) { e->update(); }
 }
 
+void MainWindow::slotFastDecompositions(bool f) {
+    DecompositionKernel::setEngine(f ? DecompositionKernel::FAST : DecompositionKernel::LEGACY);
+    updateOp();
+}
+
+void MainWindow::slotSaveStatistics() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Save statistics", "statistics.json",
+                                                    "JSON (*.json);;CSV (*.csv)");
+    if (not fileName.isEmpty() and not writeStatistics(fileName)) {
+        QMessageBox::warning(this, "Save statistics", "Cannot write " + fileName);
+    }
+}
+
+void MainWindow::slotOpenSession() {
+    QString fileName =
+        QFileDialog::getOpenFileName(this, "Open session", QString(), "Sessions (*.bloch)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    SessionReader reader;
+    if (not reader.open(fileName)) {
+        QMessageBox::warning(this, "Open session", fileName + ": " + reader.errorString());
+        return;
+    }
+
+    const QVector<sessionvector> &saved = reader.getVectors();
+
+    int count = qBound(1, saved.size(), maxCountOfSpheres());
+    while (spheres.size() > count) {
+        slotMinusSphere();
+    }
+    while (spheres.size() < count) {
+        slotPlusSphere();
+    }
+    for (int k = 0; k < count and k < saved.size(); ++k) {
+        Vector *v = vectorWidgets[k]->getVector();
+        Spike   s;
+        s.point = saved[k].point;
+        v->changeVector(s);
+        v->setName(saved[k].name);
+        v->setSelfColor(saved[k].selfColor);
+        v->setTraceColor(saved[k].traceColor);
+        v->setEnableTrace(saved[k].traceEnabled);
+        // One copy of the mapped vertices; the reader unmaps them when it goes out of scope
+        v->assignTrace(saved[k].trace);
+        vectorWidgets[k]->fillFieldsOfVector(s);
+    }
+
+    opQueue.clear();
+    opQueWid->clear();
+    foreach (auto op, reader.getQueue()) { new OpItem(opQueWid, op.getOperatorName(), op); }
+    if (reader.hasCircuit()) {
+        circuit->setModel(reader.getCircuit());
+    }
+    slotUpdateSpheres();
+    statusBar()->showMessage("Opened " + fileName);
+}
+
+void MainWindow::slotSaveSession() {
+    QString fileName = QFileDialog::getSaveFileName(this, "Save session", "session.bloch",
+                                                    "Sessions (*.bloch)");
+    if (fileName.isEmpty()) {
+        return;
+    }
+
+    // Written chunk by chunk, the traces straight from their vertex arrays
+    SessionWriter writer(fileName);
+    bool          isWritten = writer.isOpen();
+    foreach (auto e, vectorWidgets) {
+        if (e->getVector() != nullptr) {
+            isWritten = isWritten and writer.writeVector(*e->getVector());
+        }
+    }
+    QVector<Operator> queue;
+    for (int i = 0; i < opQueWid->count(); ++i) {
+        queue.append(static_cast<OpItem *>(opQueWid->item(i))->getOp());
+    }
+    isWritten = isWritten and writer.writeQueue(queue) and
+                writer.writeCircuit(circuit->getModel()) and writer.commit();
+    if (not isWritten) {
+        QMessageBox::warning(this, "Save session",
+                             "Cannot write " + fileName + ": " + writer.errorString());
+    }
+}
+
+void MainWindow::slotExportVideo(bool f) {
+    if (f) {
+        startExport();
+    } else {
+        slotStopExport();
+    }
+}
+
+// Frames of the first sphere go to a file as they are painted, or through ffmpeg for any other
+// format, so an export of any length takes constant memory
+void MainWindow::startExport() {
+    QString fileName = QFileDialog::getSaveFileName(
+        this, "Export video", "animation.y4m",
+        "YUV4MPEG2 video (*.y4m);;Raw RGBA frames (*.rgba);;Video through ffmpeg (*.mp4 *.mkv "
+        "*.webm)");
+    if (fileName.isEmpty()) {
+        exportAct->setChecked(false);
+        return;
+    }
+
+    QString    suffix = QFileInfo(fileName).suffix().toLower();
+    QIODevice *device = nullptr;
+    if (suffix == "y4m" or suffix == "rgba") {
+        exportFile = new QFile(fileName);
+        device = exportFile;
+        if (not exportFile->open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+            QMessageBox::warning(this, "Export video",
+                                 "Cannot write " + fileName + ": " + exportFile->errorString());
+        }
+    } else {
+        encoder = new QProcess(this);
+        device = encoder;
+        encoder->start("ffmpeg", QStringList{"-y", "-loglevel", "error", "-f", "yuv4mpegpipe", "-i",
+                                             "-", fileName});
+        connect(encoder, SIGNAL(finished(int, QProcess::ExitStatus)),
+                SLOT(slotEncoderFinished(int, QProcess::ExitStatus)));
+        if (not encoder->waitForStarted()) {
+            QMessageBox::warning(this, "Export video",
+                                 "Cannot start ffmpeg: " + encoder->errorString());
+        }
+    }
+    if (not device->isOpen()) {
+        delete exportFile;
+        delete encoder;
+        exportFile = nullptr;
+        encoder = nullptr;
+        exportAct->setChecked(false);
+        return;
+    }
+
+    // Frames come from one sphere in order, so the sink never holds more than one
+    int framesPerSecond = qMax(1, qRound(QGuiApplication::primaryScreen()->refreshRate()));
+    if (suffix == "rgba") {
+        exportSink = new RawFrameSink(device, 1);
+    } else {
+        exportSink = new Y4mFrameSink(device, 1, framesPerSecond);
+    }
+    // Resizing the window must not change the size of the frames
+    exportMinimumSize = spheres[0]->minimumSize();
+    exportMaximumSize = spheres[0]->maximumSize();
+    spheres[0]->setFixedSize(spheres[0]->size());
+    spheres[0]->startExport(exportSink);
+    spheres[0]->update();
+}
+
+void MainWindow::slotStopExport() {
+    if (exportSink == nullptr) {
+        return;
+    }
+
+    QString error;
+    if (not finishExport(&error)) {
+        if (encoder != nullptr) {
+            encoder->disconnect(this);
+            delete encoder;
+            encoder = nullptr;
+        }
+        QMessageBox::warning(this, "Export video", "The export stopped: " + error);
+    } else if (encoder != nullptr) {
+        // ffmpeg encodes the rest in the background; slotEncoderFinished() tells how it went
+        encoder->closeWriteChannel();
+        exportAct->setEnabled(false);
+        statusBar()->showMessage("Encoding the video");
+    }
+}
+
+void MainWindow::slotEncoderFinished(int exitCode, QProcess::ExitStatus status) {
+    // ffmpeg quitting before the export stopped is a failure as well
+    bool    isEncoded = exportSink == nullptr and status == QProcess::NormalExit and exitCode == 0;
+    QString error = QString::fromLocal8Bit(encoder->readAllStandardError());
+    if (exportSink != nullptr) {
+        QString ignored;
+        finishExport(&ignored);
+    }
+    encoder->deleteLater();
+    encoder = nullptr;
+    exportAct->setEnabled(true);
+    if (isEncoded) {
+        statusBar()->showMessage("Exported the video");
+    } else {
+        QMessageBox::warning(this, "Export video", "ffmpeg failed: " + error);
+    }
+}
+
+bool MainWindow::finishExport(QString *error) {
+    bool isWritten = spheres[0]->stopExport(error);
+    if (isWritten and not exportSink->finish()) {
+        *error = exportSink->errorString();
+        isWritten = false;
+    }
+    delete exportSink;
+    delete exportFile;
+    exportSink = nullptr;
+    exportFile = nullptr;
+
+    spheres[0]->setMinimumSize(exportMinimumSize);
+    spheres[0]->setMaximumSize(exportMaximumSize);
+    exportAct->setChecked(false);
+    return isWritten;
+}
+
+QJsonObject MainWindow::collectStatistics() const {
+    QJsonObject clock;
+    clock["refreshRate"] = QGuiApplication::primaryScreen()->refreshRate();
+    clock["jitter"] = Instrumentation::getJitter().toJson();
+    clock["droppedFrames"] = Instrumentation::getDroppedFrames();
+
+    QJsonArray sphereStats;
+    for (auto &sphere : spheres) {
+        QJsonArray vectorStats;
+        for (auto &e : sphere->getVectors()) {
+            QJsonObject v;
+            v["name"] = e->getName();
+            v["pathFrame"] = e->getPathFrame();
+            v["pathLength"] = e->getPathSize();
+            v["traceSegments"] = e->getTrace().countOfSegments();
+            v["traceBytes"] = e->getTrace().countOfBytes();
+            vectorStats.append(v);
+        }
+        QJsonObject s;
+        s["paint"] = sphere->getPaintTime().toJson();
+        s["vectors"] = vectorStats;
+        sphereStats.append(s);
+    }
+
+    cachestatistics cacheStats = Operator::getCacheStatistics();
+    QJsonObject     cache;
+    cache["hits"] = double(cacheStats.hits);
+    cache["misses"] = double(cacheStats.misses);
+    cache["size"] = cacheStats.size;
+    cache["capacity"] = cacheStats.capacity;
+
+    QJsonObject json;
+    json["clock"] = clock;
+    json["spheres"] = sphereStats;
+    json["decompositionCache"] = cache;
+    return json;
+}
+
+namespace {
+// One "key,value" row per leaf, nested keys joined with dots
+void writeCsv(QTextStream &out, const QString &key, const QJsonValue &value) {
+    QString prefix = key.isEmpty() ? key : key + ".";
+    if (value.isObject()) {
+        QJsonObject object = value.toObject();
+        for (auto it = object.constBegin(); it != object.constEnd(); ++it) {
+            writeCsv(out, prefix + it.key(), it.value());
+        }
+    } else if (value.isArray()) {
+        QJsonArray array = value.toArray();
+        for (int i = 0; i < array.size(); ++i) {
+            writeCsv(out, prefix + QString::number(i), array[i]);
+        }
+    } else {
+        QString text = value.isDouble() ? QString::number(value.toDouble()) : value.toString();
+        out << key << "," << text << "\n";
+    }
+}
+} // namespace
+
+bool MainWindow::writeStatistics(const QString &fileName) const {
+    QFile file(fileName);
+    if (not file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        return false;
+    }
+
+    QJsonObject json = collectStatistics();
+    if (fileName.endsWith(".csv", Qt::CaseInsensitive)) {
+        QTextStream out(&file);
+        out << "key,value\n";
+        writeCsv(out, "", json);
+    } else {
+        file.write(QJsonDocument(json).toJson());
+    }
+    return true;
+}
+
+void MainWindow::slotUpdateSpheres() { updateDirtySpheres(); }
+
+void MainWindow::slotRefreshVisibleFields() {
+    fieldsClock.start();
+    auto vectorWidget = qobject_cast<VectorWidget *>(topTabWid->currentWidget());
+    if (vectorWidget != nullptr) {
+        vectorWidget->refreshFields();
+    }
+}
+
+bool MainWindow::updateDirtySpheres() {
+    bool updated = false;
+    foreach (auto e, spheres) { updated |= e->updateIfDirty(); }
+    // The clock sphere swaps a frame for the next step even when its own vectors stand still
+    if (updated) {
+        spheres[0]->update();
+    }
+    return updated;
+}
+
 void MainWindow::slotSpeedUp() {
     if (Utility::getSpeed() < 10) {
         Utility::setSpeed(Utility::getSpeed() + 1);
@@ -21,17 +21,24 @@
 #include "OpItem.h"
 #include "Sphere.h"
 #include "VectorWidget.h"
+#include "WidgetUtility.h"
+#include "src/quantum/CircuitPlanner.h"
 #include "src/quantum/Operator.h"
 #include "src/quantum/Qubit.h"
 #include "src/utility.h"
 #include <QActionGroup>
+#include <QCheckBox>
 #include <QComboBox>
 #include <QDialog>
+#include <QElapsedTimer>
+#include <QFile>
 #include <QGridLayout>
+#include <QJsonObject>
 #include <QLabel>
 #include <QListWidgetItem>
 #include <QMainWindow>
 #include <QMap>
+#include <QProcess>
 #include <QPushButton>
 #include <QRadioButton>
 #include <QVector>
@@ -40,7 +47,7 @@ enum OPERATOR_FORM { NOTHING = 0, MATRIX, VECTOR };
 
 typedef QMap<Vector *, QVector<Sphere *>> MapVectors;
 
-typedef QVector<Spike> (Operator::*CurDecompFun)(Spike);
+typedef Path (Operator::*CurDecompFun)(Spike);
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -69,6 +76,7 @@ public slots:
     void slotApplyQue();
 
     void slotUpdateSpheres();
+    void slotRefreshVisibleFields();
     void slotReset();
     void slotClear();
     void slotShowTrace();
@@ -85,6 +93,14 @@ public slots:
     void slotToggleRotateVector(bool f);
     void slotToggleAutoNormalize(bool f);
     void slotAbout();
+    void slotShowStatistics(bool f);
+    void slotFastDecompositions(bool f);
+    void slotSaveStatistics();
+    void slotOpenSession();
+    void slotSaveSession();
+    void slotExportVideo(bool f);
+    void slotStopExport();
+    void slotEncoderFinished(int exitCode, QProcess::ExitStatus status);
 
     void slotPlusSphere();
     void slotMinusSphere();
@@ -94,12 +110,23 @@ public slots:
     void slotStartCircuitMove();
 
 private:
+    // The first one is the clock sphere, whose frames pace the animation
     QVector<Sphere *> spheres;
+    // One per sphere, in tab order
+    QVector<VectorWidget *> vectorWidgets;
+    // Vectors playing a path, stepped by slotTimer
+    QVector<Vector *> animatingVectors;
     MapVectors        vectors;
     MapVectors        savedVectors;
     bool              isAutoNormalize = true;
-    QTimer           *tm = nullptr;
-    Circuit          *circuit = nullptr;
+    // Fires only when no sphere has swapped a frame for a while, e.g. when they are all hidden
+    QTimer       *tm = nullptr;
+    QElapsedTimer frameClock;
+    QElapsedTimer fieldsClock;
+    Circuit      *circuit = nullptr;
+    // State of all circuit qubits together, a step ahead of the spheres, which show its reduced
+    // Bloch vectors
+    CircuitPlanner circuitPlanner;
 
     QWidget     *controlWidget = nullptr;
     QVBoxLayout *controlLayout = nullptr;
@@ -107,20 +134,35 @@ private:
 
     void createSideWidget();
     void createSphere();
+    // Signals every sphere needs, whether made at start or added later
+    void connectSphere(Sphere *sphere);
     void createMenu();
     void createActions();
     void createTopBar();
     void createOpQueWidget();
 
     void startTimer();
+    // Also pauses between the operators of a queue and the steps of a circuit
     void stopTimer();
+    // Stops an animation for good and writes the statistics to the BLOCHSPHERE_STATS file
+    void finishAnimation();
 
     void setEnabledWidgets(bool f);
+    // Limit of Utility, but no more qubits than a circuit can simulate
+    static int maxCountOfSpheres();
+    bool updateDirtySpheres();
+
+    void startExport();
+    // Stops capturing and closes the sink; false with the reason in error if a frame was lost
+    bool finishExport(QString *error);
+
+    QJsonObject collectStatistics() const;
+    bool        writeStatistics(const QString &fileName) const;
 
     void nextAnimStepCircuit();
 
     void         startMove(Vector *v, CurDecompFun getDec);
-    void         startMove(Vector *v, Operator &op, CurDecompFun getDec);
+    void         startMove(Vector *v, Operator &op, const Path &path);
     CurDecompFun getCurrentDecomposition();
     void         updateOp(OPERATOR_FORM exclude = OPERATOR_FORM::NOTHING);
 
@@ -137,6 +179,8 @@ private:
     QPushButton *appBut = nullptr;
     QPushButton *appQueBut = nullptr;
     QPushButton *clrQueBut = nullptr;
+    // Runs the queue as the single product of its operators
+    QCheckBox *fuseQueBox = nullptr;
 
     QTabWidget *rxyzTab = nullptr;
 
@@ -186,6 +230,7 @@ private:
     QComboBox        *colorComboBox = nullptr;
     bool              isQueueAnimation = false;
     bool              isCircuitAnimation = false;
+    bool              isFusedQueue = false;
     QVector<OpItem *> opQueue;
 
     QListWidget *opQueWid = nullptr;
@@ -196,6 +241,20 @@ private:
     QAction *exitAct = nullptr;
     QAction *showTAct = nullptr;
     QAction *clearTAct = nullptr;
+    QAction *showStatAct = nullptr;
+    QAction *saveStatAct = nullptr;
+    QAction *openSessAct = nullptr;
+    QAction *saveSessAct = nullptr;
+    QAction *exportAct = nullptr;
+    QAction *fastEngAct = nullptr;
+
+    // Open while the first sphere exports its frames, to a file or into ffmpeg
+    FrameSink *exportSink = nullptr;
+    QFile     *exportFile = nullptr;
+    QProcess  *encoder = nullptr;
+    // Size limits of the first sphere from before the export fixed its size
+    QSize exportMinimumSize;
+    QSize exportMaximumSize;
 
     int easterEggCounter = 0;
 };
@@ -0,0 +1,57 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "Mesh.h"
+
+void Mesh::append(GLfloat x, GLfloat y, GLfloat z) {
+    vertices.append(x);
+    vertices.append(y);
+    vertices.append(z);
+}
+
+void Mesh::upload() {
+    if (uploaded or not buffer.create()) {
+        return;
+    }
+    buffer.setUsagePattern(QOpenGLBuffer::StaticDraw);
+    buffer.bind();
+    buffer.allocate(vertices.constData(), vertices.size() * static_cast<int>(sizeof(GLfloat)));
+    buffer.release();
+    uploaded = true;
+}
+
+void Mesh::destroy() {
+    buffer.destroy();
+    uploaded = false;
+}
+
+void Mesh::draw(GLenum mode) {
+    if (uploaded) {
+        buffer.bind();
+        glEnableClientState(GL_VERTEX_ARRAY);
+        glVertexPointer(3, GL_FLOAT, 0, nullptr);
+        glDrawArrays(mode, 0, size());
+        glDisableClientState(GL_VERTEX_ARRAY);
+        buffer.release();
+        return;
+    }
+
+    glBegin(mode);
+    for (int i = 0; i < vertices.size(); i += 3) {
+        glVertex3f(vertices[i], vertices[i + 1], vertices[i + 2]);
+    }
+    glEnd();
+}
@@ -0,0 +1,50 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef MESH_HPP
+#define MESH_HPP
+
+#include <QGLWidget>
+#include <QOpenGLBuffer>
+#include <QVector3D>
+#include <QVector>
+
+// Static geometry for the fixed-function pipeline. upload() puts the vertices into a vertex
+// buffer object once; on contexts without VBO support draw() sends them in immediate mode.
+class Mesh {
+public:
+    Mesh() : buffer(QOpenGLBuffer::VertexBuffer) {}
+
+    void append(GLfloat x, GLfloat y, GLfloat z);
+    int  size() const { return vertices.size() / 3; }
+    // For drawing without GL
+    QVector3D vertex(int i) const {
+        return QVector3D(vertices[3 * i], vertices[3 * i + 1], vertices[3 * i + 2]);
+    }
+
+    // Both need the GL context to be current
+    void upload();
+    void destroy();
+
+    void draw(GLenum mode);
+
+private:
+    QVector<GLfloat> vertices;
+    QOpenGLBuffer    buffer;
+    bool             uploaded = false;
+};
+
+#endif // MESH_HPP
@@ -0,0 +1,102 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "OffscreenRenderer.h"
+
+namespace {
+// Multisampling as the window gets from a default format on most drivers
+const int SAMPLES = 4;
+} // namespace
+
+OffscreenRenderer::OffscreenRenderer(const QSize &size, bool software)
+    : size(size), software(software) {
+    scene.setSize(size.width(), size.height());
+    if (not software) {
+        surface = new QOffscreenSurface();
+        surface->create();
+    }
+}
+
+OffscreenRenderer::~OffscreenRenderer() {
+    end();
+    delete surface;
+}
+
+bool OffscreenRenderer::begin() {
+    if (context != nullptr) {
+        return true;
+    }
+    if (software or not surface->isValid()) {
+        return false;
+    }
+
+    context = new QOpenGLContext();
+    context->setFormat(surface->requestedFormat());
+    if (not context->create() or not context->makeCurrent(surface)) {
+        delete context;
+        context = nullptr;
+        return false;
+    }
+
+    QOpenGLFramebufferObjectFormat format;
+    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    format.setSamples(SAMPLES);
+    fbo = new QOpenGLFramebufferObject(size, format);
+    if (not fbo->isValid()) {
+        end();
+        return false;
+    }
+
+    scene.upload();
+    scene.resize(size.width(), size.height());
+    return true;
+}
+
+void OffscreenRenderer::end() {
+    if (context == nullptr) {
+        return;
+    }
+    context->makeCurrent(surface);
+    scene.destroy();
+    delete fbo;
+    fbo = nullptr;
+    context->doneCurrent();
+    delete context;
+    context = nullptr;
+}
+
+QImage OffscreenRenderer::render(const spherecamera &camera, const QList<Vector *> &vectors) {
+    QImage image;
+    if (context != nullptr) {
+        fbo->bind();
+        scene.draw(camera, vectors);
+        fbo->release();
+        // Resolves the samples and waits for the frame
+        image = fbo->toImage();
+    } else {
+        image = QImage(size, QImage::Format_ARGB32_Premultiplied);
+    }
+
+    QPainter painter(&image);
+    if (context == nullptr) {
+        scene.paint(&painter, camera, vectors);
+    } else {
+        painter.setRenderHint(QPainter::TextAntialiasing);
+        scene.paintLabels(&painter, camera, vectors);
+    }
+    return image;
+}
@@ -0,0 +1,56 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef OFFSCREENRENDERER_HPP
+#define OFFSCREENRENDERER_HPP
+
+#include "SphereScene.h"
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+
+// Renders a SphereScene into images without a window: into a framebuffer object on an offscreen
+// surface, or with QPainter where there is no OpenGL, e.g. under QT_QPA_PLATFORM=offscreen on a
+// machine without a GL driver. The surface is made on the GUI thread with the renderer; begin(),
+// render() and end() then run on one other thread, and each renderer has a context of its own,
+// so that several render at once.
+class OffscreenRenderer {
+public:
+    OffscreenRenderer(const QSize &size, bool software);
+    ~OffscreenRenderer();
+    OffscreenRenderer(const OffscreenRenderer &) = delete;
+    OffscreenRenderer &operator=(const OffscreenRenderer &) = delete;
+
+    // Makes the context current on the calling thread; false when frames are painted instead
+    bool begin();
+    // Frees the GL objects; on the thread that called begin()
+    void end();
+
+    QImage render(const spherecamera &camera, const QList<Vector *> &vectors);
+    QSize  getSize() const { return size; }
+
+private:
+    QSize                     size;
+    bool                      software;
+    SphereScene               scene;
+    QOffscreenSurface        *surface = nullptr;
+    QOpenGLContext           *context = nullptr;
+    QOpenGLFramebufferObject *fbo = nullptr;
+};
+
+#endif // OFFSCREENRENDERER_HPP
@@ -15,54 +15,146 @@
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
 #include "Sphere.h"
+#include <QElapsedTimer>
+#include <QFontMetrics>
 #include <QMouseEvent>
-#include <QQuaternion>
+#include <QStringList>
 
-Sphere::Sphere(QWidget *parent) : QGLWidget{parent} { toNormal(); }
+namespace {
+QGLFormat swapFormat(bool vsync) {
+    QGLFormat format = QGLFormat::defaultFormat();
+    format.setSwapInterval(vsync ? 1 : 0);
+    return format;
+}
+} // namespace
+
+Sphere::Sphere(QWidget *parent, bool isClock)
+    : QGLWidget{swapFormat(isClock), parent}, clock(isClock) {
+    toNormal();
+}
+
+Sphere::~Sphere() {
+    makeCurrent();
+    if (frameExport != nullptr) {
+        frameExport->finish();
+        delete frameExport;
+    }
+    scene.destroy();
+    doneCurrent();
+}
 
 void Sphere::deleteVector(Vector *v) {
     if (vectors.indexOf(v) != -1) {
         vectors.removeOne(v);
     }
+    drawnRevisions.remove(v);
+    makeCurrent();
+    scene.destroyTrace(v);
+    doneCurrent();
 }
 
-void Sphere::initializeGL() { qglClearColor(Qt::white); }
-
-void Sphere::resizeGL(int w, int h) {
-    glMatrixMode(GL_PROJECTION);
-    glLoadIdentity();
+bool Sphere::updateIfDirty() {
+    bool dirty = Instrumentation::isEnabled() or drawnRevisions.size() != vectors.size();
+    for (int i = 0; not dirty and i < vectors.size(); ++i) {
+        auto it = drawnRevisions.constFind(vectors[i]);
+        dirty = it == drawnRevisions.constEnd() or it.value() != vectors[i]->getRevision();
+    }
+    if (dirty) {
+        update();
+    }
+    return dirty;
+}
 
-    GLfloat ratio = static_cast<GLfloat>(h) / w;
+void Sphere::startExport(FrameSink *sink) {
+    delete frameExport;
+    frameExport = new FrameExport(sink);
+    exportError.clear();
+}
 
-    if (w >= h) {
-        glOrtho(-2.0 / ratio, 2.0 / ratio, -2.0, 2.0, -10.0, 10.0);
-    } else {
-        glOrtho(-2.0, 2.0, -2.0 * ratio, 2.0 * ratio, -10.0, 10.0);
+bool Sphere::stopExport(QString *error) {
+    if (frameExport != nullptr) {
+        makeCurrent();
+        if (not frameExport->finish()) {
+            exportError = frameExport->errorString();
+        }
+        doneCurrent();
+        delete frameExport;
+        frameExport = nullptr;
     }
-    glViewport(0, 0, w, h);
+    *error = exportError;
+    return exportError.isEmpty();
 }
 
+void Sphere::initializeGL() { scene.upload(); }
+
+void Sphere::resizeGL(int w, int h) { scene.resize(w, h); }
+
 void Sphere::paintGL() {
-    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+    QElapsedTimer paintClock;
+    paintClock.start();
+
+    scene.draw(camera(), vectors);
+    glColor3f(0.0f, 0.0f, 0.0f);
+    for (const scenelabel &label : scene.labels(vectors)) {
+        renderText(label.point.x(), label.point.y(), label.point.z(), label.text,
+                   scene.getFont());
+    }
 
-    glMatrixMode(GL_MODELVIEW);
-    glLoadIdentity();
+    drawnRevisions.clear();
+    for (auto &e : vectors) {
+        drawnRevisions.insert(e, e->getRevision());
+    }
 
-    glScalef(scaleFactor, scaleFactor, scaleFactor);
+    if (Instrumentation::isEnabled()) {
+        paintTime.add(paintClock.nsecsElapsed() / 1e6);
+        drawStatistics();
+    }
 
-    glRotatef(xAngle, 1.0f, 0.0f, 0.0f);
-    glRotatef(yAngle, 0.0f, 1.0f, 0.0f);
-    glRotatef(zAngle, 0.0f, 0.0f, 1.0f);
+    if (frameExport != nullptr and
+        not frameExport->capture(width() * devicePixelRatio(), height() * devicePixelRatio())) {
+        exportError = frameExport->errorString();
+        frameExport->finish();
+        delete frameExport;
+        frameExport = nullptr;
+        emit signalExportFailed();
+    }
+}
 
-    glColor4f(0.85f, 0.85f, 0.85f, 0.5f);
-    drawSphere(50, 50);
+void Sphere::glDraw() {
+    QGLWidget::glDraw();
+    emit signalFrameSwapped();
+    // Exported videos play at the refresh rate, so every vsync becomes a frame, changed or not
+    if (frameExport != nullptr) {
+        update();
+    }
+}
 
-    drawCircle();
+void Sphere::drawStatistics() {
+    const Measure &jitter = Instrumentation::getJitter();
+
+    QStringList lines;
+    lines << QString("paint %1 ms (avg %2, max %3)")
+                 .arg(paintTime.last(), 0, 'f', 2)
+                 .arg(paintTime.average(), 0, 'f', 2)
+                 .arg(paintTime.max(), 0, 'f', 2);
+    lines << QString("frame jitter %1 ms (max %2), dropped %3")
+                 .arg(jitter.average(), 0, 'f', 2)
+                 .arg(jitter.max(), 0, 'f', 2)
+                 .arg(Instrumentation::getDroppedFrames());
+    for (auto &e : vectors) {
+        lines << QString("%1: path %2/%3, trace %4 seg, %5 KiB")
+                     .arg(e->getName())
+                     .arg(e->getPathFrame())
+                     .arg(e->getPathSize())
+                     .arg(e->getTrace().countOfSegments())
+                     .arg(e->getTrace().countOfBytes() / 1024., 0, 'f', 1);
+    }
 
-    glEnable(GL_DEPTH_TEST);
-    drawAxis();
-    glDisable(GL_DEPTH_TEST);
-    drawVectors();
+    qglColor(Qt::darkGray);
+    const int lineHeight = QFontMetrics(scene.getFont()).height();
+    for (int i = 0; i < lines.size(); ++i) {
+        renderText(5, lineHeight * (i + 1), lines[i], scene.getFont());
+    }
 }
 
 void Sphere::mousePressEvent(QMouseEvent *pe) {
@@ -97,170 +189,6 @@ void Sphere::wheelEvent(QWheelEvent *pe) {
     updateGL();
 }
 
-void Sphere::drawSphere(int lats, int longs) {
-    for (int i = 0; i <= lats; i++) {
-        double lat0 = M_PI * (-0.5 + static_cast<double>(i - 1.) / lats);
-        double z0 = sin(lat0);
-        double zr0 = cos(lat0);
-
-        double lat1 = M_PI * (-0.5 + static_cast<double>(i) / lats);
-        double z1 = sin(lat1);
-        double zr1 = cos(lat1);
-
-        glBegin(GL_QUAD_STRIP);
-        for (int j = 0; j <= longs; j++) {
-            double lng = 2 * M_PI * static_cast<double>(j - 1) / longs;
-            double x = cos(lng);
-            double y = sin(lng);
-
-            glVertex3f(x * zr0, y * zr0, z0);
-            glVertex3f(x * zr1, y * zr1, z1);
-        }
-        glEnd();
-    }
-}
-
-void Sphere::drawCircle() {
-    glColor4f(0.7f, 0.8f, 0.8f, 0.5f);
-
-    glBegin(GL_POLYGON);
-    float i = 0;
-    while (i < 6.28f) {
-        glVertex2f(sphereRadius * sin(i), sphereRadius * cos(i));
-        i += 0.157f; // 3.14/20
-    }
-    glEnd();
-
-    glLineWidth(1.5f);
-    glColor3f(0.6f, 0.7f, 0.7f);
-
-    glBegin(GL_LINE_LOOP);
-    i = 0;
-    while (i < 6.28f) {
-        glVertex2f(sphereRadius * sin(i), sphereRadius * cos(i));
-        i += 0.157f; // 3.14/20
-    }
-    glEnd();
-
-    glColor3f(0.0f, 0.0f, 0.0f);
-
-    renderText(0.0, 0.05, -1.2, "|1>", font);
-    renderText(0.0, 0.05, 1.2, "|0>", font);
-}
-
-void Sphere::drawAxis() {
-    float axSize = 1.7f;
-
-    glLineWidth(2.3f);
-    // OX
-    qglColor(Qt::black);
-    glBegin(GL_LINES);
-    glVertex3f(axSize, 0.f, 0.f);
-    glVertex3f(-axSize, 0.f, 0.f);
-
-    glVertex3f(axSize, 0.f, 0.f);
-    glVertex3f(axSize - 0.1, 0.f, 0.025f);
-    glVertex3f(axSize, 0.f, 0.f);
-    glVertex3f(axSize - 0.1, 0.f, -0.025f);
-
-    glVertex3f(axSize, 0.f, 0.f);
-    glVertex3f(axSize - 0.1f, 0.025f, 0.f);
-    glVertex3f(axSize, 0.f, 0.f);
-    glVertex3f(axSize - 0.1f, -0.025f, 0.f);
-    glEnd();
-    renderText(axSize + 0.1, 0.0, 0.0, "x", font);
-
-    // OY
-    qglColor(Qt::black);
-    glBegin(GL_LINES);
-    glVertex3f(0.f, axSize, 0.f);
-    glVertex3f(0.f, -axSize, 0.f);
-
-    glVertex3f(0.f, axSize, 0.f);
-    glVertex3f(0.f, axSize - 0.1f, 0.025f);
-    glVertex3f(0.f, axSize, 0.f);
-    glVertex3f(0.f, axSize - 0.1f, -0.025f);
-
-    glVertex3f(0.f, axSize, 0.f);
-    glVertex3f(0.025f, axSize - 0.1f, 0.f);
-    glVertex3f(0.f, axSize, 0.f);
-    glVertex3f(-0.025f, axSize - 0.1f, 0.f);
-    glEnd();
-    renderText(0, axSize + 0.1f, 0.f, "y", font);
-
-    // OZ
-    qglColor(Qt::black);
-    glBegin(GL_LINES);
-    glVertex3f(0.f, 0.f, axSize);
-    glVertex3f(0.f, 0.f, -axSize);
-
-    glVertex3f(0.f, 0.f, axSize);
-    glVertex3f(0.025f, 0.f, axSize - 0.1f);
-    glVertex3f(0.f, 0.f, axSize);
-    glVertex3f(-0.025f, 0.f, axSize - 0.1f);
-
-    glVertex3f(0.f, 0.f, axSize);
-    glVertex3f(0.f, 0.025f, axSize - 0.1f);
-    glVertex3f(0.f, 0.f, axSize);
-    glVertex3f(0.f, -0.025f, axSize - 0.1f);
-    glEnd();
-    renderText(0, 0, axSize + 0.1f, "z", font);
-}
-
-void Sphere::drawVectors() {
-    for (auto &e : vectors) {
-        if (e->isTraceEnabled()) {
-            renderText(1.2, -1.2, 1.2, e->getInfo(), font);
-            glEnable(GL_DEPTH_TEST);
-            for (auto &segment : e->getTrace()) {
-                glColor3f(segment.color.redF(), segment.color.greenF(), segment.color.blueF());
-                glLineWidth(2.5f);
-                glBegin(GL_LINES);
-
-                glVertex3f(segment.first.x(), segment.first.y(), segment.first.z());
-                glVertex3f(segment.last.x(), segment.last.y(), segment.last.z());
-
-                glEnd();
-            }
-            glDisable(GL_DEPTH_TEST);
-        }
-
-        if (e->isRotateVectorEnable()) {
-            qglColor(Qt::blue);
-            glLineWidth(3.f);
-            glBegin(GL_LINES);
-            glVertex3f(e->rotateVector().x(), e->rotateVector().y(), e->rotateVector().z());
-            glVertex3f(-e->rotateVector().x(), -e->rotateVector().y(), -e->rotateVector().z());
-            glEnd();
-        }
-
-        glColor3f(e->getSelfColor().redF(), e->getSelfColor().greenF(), e->getSelfColor().blueF());
-        glLineWidth(2.5f);
-
-        glBegin(GL_LINES);
-        glVertex3f(0, 0, 0);
-
-        QVector3D vertex = e->getSpike().point;
-
-        glVertex3f(vertex.x(), vertex.y(), vertex.z());
-
-        glEnd();
-
-        glBegin(GL_LINES);
-
-        QVector<QVector3D> arrowhead;
-        arrowhead.append(e->getSpike().arrow1);
-        arrowhead.append(e->getSpike().arrow2);
-        arrowhead.append(e->getSpike().arrow3);
-        arrowhead.append(e->getSpike().arrow4);
-        for (auto &i : arrowhead) {
-            glVertex3f(vertex.x(), vertex.y(), vertex.z());
-            glVertex3f(i.x(), i.y(), i.z());
-        }
-        glEnd();
-    }
-}
-
 void Sphere::toYoZ() {
     scaleFactor = 1;
     xAngle = -90;
@@ -17,14 +17,21 @@
 #ifndef SPHERE_HPP
 #define SPHERE_HPP
 
+#include "FrameExport.h"
+#include "Instrumentation.h"
+#include "SphereScene.h"
 #include "src/quantum/Vector.h"
 #include <QDebug>
 #include <QGLWidget>
+#include <QHash>
 
 class Sphere : public QGLWidget {
     Q_OBJECT
 public:
-    explicit Sphere(QWidget *parent);
+    // Only the clock sphere waits for vsync when it swaps, and its swaps pace the animation; the
+    // others swap at once, so that more spheres do not take more refreshes per frame
+    Sphere(QWidget *parent, bool isClock);
+    ~Sphere() override;
     void addVector(Vector *v) { vectors.append(v); }
     void deleteVector(Vector *v);
     void toYoZ();
@@ -33,30 +40,54 @@ public:
     void easterEggRotate();
     void toNormal();
 
+    // Repaints when a vector changed since the last paint; camera changes repaint on their own
+    bool updateIfDirty();
+
+    bool                   isClock() const { return clock; }
+    const QList<Vector *> &getVectors() const { return vectors; }
+    const Measure         &getPaintTime() const { return paintTime; }
+
+    // Repaints on every vsync and passes each frame to sink until stopExport(); the sink stays
+    // the caller's
+    void startExport(FrameSink *sink);
+    // False with the reason in error when a frame could not be passed on
+    bool stopExport(QString *error);
+
+signals:
+    // Emitted once the frame has been handed to the display; on the clock sphere this is at vsync
+    void signalFrameSwapped();
+    // A frame could not be exported and the export stopped; stopExport() tells why
+    void signalExportFailed();
+
 protected:
     void initializeGL() override;
     void resizeGL(int w, int h) override;
     void paintGL() override;
+    void glDraw() override;
     void mousePressEvent(QMouseEvent *pe) override;
     void mouseMoveEvent(QMouseEvent *pe) override;
     void wheelEvent(QWheelEvent *pe) override;
 
 private:
-    const GLfloat sphereRadius = 1;
-    const QFont   font = QFont("System", 11);
-    GLfloat       scaleFactor;
-    GLfloat       xAngle;
-    GLfloat       yAngle;
-    GLfloat       zAngle;
+    bool    clock;
+    GLfloat scaleFactor;
+    GLfloat xAngle;
+    GLfloat yAngle;
+    GLfloat zAngle;
 
     QList<Vector *> vectors;
+    SphereScene     scene;
+    // Vector::getRevision() of every vector as of the last paint
+    QHash<Vector *, unsigned> drawnRevisions;
 
     QPoint ptrMousePosition;
 
-    static void drawSphere(int lats, int longs);
-    void        drawCircle();
-    void        drawAxis();
-    void        scalePlus() {
+    Measure paintTime;
+
+    FrameExport *frameExport = nullptr;
+    QString      exportError;
+
+    void scalePlus() {
         if (scaleFactor < 5.) {
             scaleFactor *= 1.1;
         }
@@ -66,7 +97,8 @@ private:
             scaleFactor /= 1.1;
         }
     }
-    void drawVectors();
+    void         drawStatistics();
+    spherecamera camera() const { return {scaleFactor, xAngle, yAngle, zAngle}; }
 };
 
 #endif // SPHERE_HPP
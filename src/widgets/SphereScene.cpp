@@ -0,0 +1,374 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "SphereScene.h"
+
+namespace {
+QVector3D toQVector3D(const Vector3D &v) { return QVector3D(v.x(), v.y(), v.z()); }
+
+QColor toColor(const rgb &c) { return QColor::fromRgbF(c.red, c.green, c.blue); }
+
+// Ends of the arrowhead strokes at vertex, whatever its length; none at the centre
+QVector<Vector3D> arrowheadOf(const Vector3D &vertex) {
+    if (vertex.normalized().lengthSquared() == 0) {
+        return {};
+    }
+    Quaternion q = Quaternion::rotationTo(Vector3D(0, 0, 1), vertex);
+    double     back = qMax(vertex.length() - 0.1, 0.0);
+    return {q.rotatedVector(Vector3D(0.02, 0.0, back)), q.rotatedVector(Vector3D(-0.02, 0.0, back)),
+            q.rotatedVector(Vector3D(0.0, 0.02, back)),
+            q.rotatedVector(Vector3D(0.0, -0.02, back))};
+}
+} // namespace
+
+SphereScene::SphereScene() {
+    buildSphereMesh(50, 50);
+    buildCircleMesh();
+    buildAxisMesh();
+}
+
+void SphereScene::upload() {
+    glClearColor(1, 1, 1, 1);
+    sphereMesh.upload();
+    circleMesh.upload();
+    axisMesh.upload();
+}
+
+void SphereScene::destroy() {
+    sphereMesh.destroy();
+    circleMesh.destroy();
+    axisMesh.destroy();
+    for (auto &buffer : traceBuffers) {
+        buffer.destroy();
+    }
+    traceBuffers.clear();
+}
+
+void SphereScene::destroyTrace(Vector *v) {
+    if (traceBuffers.contains(v)) {
+        traceBuffers.take(v).destroy();
+    }
+}
+
+void SphereScene::setSize(int w, int h) {
+    width = qMax(w, 1);
+    height = qMax(h, 1);
+}
+
+void SphereScene::resize(int w, int h) {
+    setSize(w, h);
+
+    glMatrixMode(GL_PROJECTION);
+    glLoadIdentity();
+
+    GLfloat ratio = static_cast<GLfloat>(height) / width;
+
+    if (width >= height) {
+        glOrtho(-2.0 / ratio, 2.0 / ratio, -2.0, 2.0, -10.0, 10.0);
+    } else {
+        glOrtho(-2.0, 2.0, -2.0 * ratio, 2.0 * ratio, -10.0, 10.0);
+    }
+    glViewport(0, 0, width, height);
+}
+
+void SphereScene::draw(const spherecamera &camera, const QList<Vector *> &vectors) {
+    glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+    glMatrixMode(GL_MODELVIEW);
+    glLoadIdentity();
+
+    glScalef(camera.scale, camera.scale, camera.scale);
+
+    glRotatef(camera.xAngle, 1.0f, 0.0f, 0.0f);
+    glRotatef(camera.yAngle, 0.0f, 1.0f, 0.0f);
+    glRotatef(camera.zAngle, 0.0f, 0.0f, 1.0f);
+
+    glColor4f(0.85f, 0.85f, 0.85f, 0.5f);
+    sphereMesh.draw(GL_TRIANGLE_STRIP);
+
+    drawCircle();
+
+    glEnable(GL_DEPTH_TEST);
+    drawAxis();
+    glDisable(GL_DEPTH_TEST);
+    drawVectors(camera, vectors);
+}
+
+// Quad strips of the latitude rings joined into one triangle strip by degenerate triangles
+void SphereScene::buildSphereMesh(int lats, int longs) {
+    for (int i = 0; i <= lats; i++) {
+        double lat0 = M_PI * (-0.5 + static_cast<double>(i - 1.) / lats);
+        double z0 = sin(lat0);
+        double zr0 = cos(lat0);
+
+        double lat1 = M_PI * (-0.5 + static_cast<double>(i) / lats);
+        double z1 = sin(lat1);
+        double zr1 = cos(lat1);
+
+        for (int j = 0; j <= longs; j++) {
+            double lng = 2 * M_PI * static_cast<double>(j - 1) / longs;
+            double x = cos(lng);
+            double y = sin(lng);
+
+            if (i != 0 and j == 0) {
+                sphereMesh.append(x * zr0, y * zr0, z0);
+            }
+            sphereMesh.append(x * zr0, y * zr0, z0);
+            sphereMesh.append(x * zr1, y * zr1, z1);
+            if (i != lats and j == longs) {
+                sphereMesh.append(x * zr1, y * zr1, z1);
+            }
+        }
+    }
+}
+
+void SphereScene::buildCircleMesh() {
+    float i = 0;
+    while (i < 6.28f) {
+        circleMesh.append(sphereRadius * sin(i), sphereRadius * cos(i), 0.f);
+        i += 0.157f; // 3.14/20
+    }
+}
+
+void SphereScene::buildAxisMesh() {
+    // OX
+    axisMesh.append(axisSize, 0.f, 0.f);
+    axisMesh.append(-axisSize, 0.f, 0.f);
+
+    axisMesh.append(axisSize, 0.f, 0.f);
+    axisMesh.append(axisSize - 0.1, 0.f, 0.025f);
+    axisMesh.append(axisSize, 0.f, 0.f);
+    axisMesh.append(axisSize - 0.1, 0.f, -0.025f);
+
+    axisMesh.append(axisSize, 0.f, 0.f);
+    axisMesh.append(axisSize - 0.1f, 0.025f, 0.f);
+    axisMesh.append(axisSize, 0.f, 0.f);
+    axisMesh.append(axisSize - 0.1f, -0.025f, 0.f);
+
+    // OY
+    axisMesh.append(0.f, axisSize, 0.f);
+    axisMesh.append(0.f, -axisSize, 0.f);
+
+    axisMesh.append(0.f, axisSize, 0.f);
+    axisMesh.append(0.f, axisSize - 0.1f, 0.025f);
+    axisMesh.append(0.f, axisSize, 0.f);
+    axisMesh.append(0.f, axisSize - 0.1f, -0.025f);
+
+    axisMesh.append(0.f, axisSize, 0.f);
+    axisMesh.append(0.025f, axisSize - 0.1f, 0.f);
+    axisMesh.append(0.f, axisSize, 0.f);
+    axisMesh.append(-0.025f, axisSize - 0.1f, 0.f);
+
+    // OZ
+    axisMesh.append(0.f, 0.f, axisSize);
+    axisMesh.append(0.f, 0.f, -axisSize);
+
+    axisMesh.append(0.f, 0.f, axisSize);
+    axisMesh.append(0.025f, 0.f, axisSize - 0.1f);
+    axisMesh.append(0.f, 0.f, axisSize);
+    axisMesh.append(-0.025f, 0.f, axisSize - 0.1f);
+
+    axisMesh.append(0.f, 0.f, axisSize);
+    axisMesh.append(0.f, 0.025f, axisSize - 0.1f);
+    axisMesh.append(0.f, 0.f, axisSize);
+    axisMesh.append(0.f, -0.025f, axisSize - 0.1f);
+}
+
+void SphereScene::drawCircle() {
+    glColor4f(0.7f, 0.8f, 0.8f, 0.5f);
+    circleMesh.draw(GL_POLYGON);
+
+    glLineWidth(1.5f);
+    glColor3f(0.6f, 0.7f, 0.7f);
+    circleMesh.draw(GL_LINE_LOOP);
+}
+
+void SphereScene::drawAxis() {
+    glLineWidth(2.3f);
+    glColor3f(0.0f, 0.0f, 0.0f);
+    axisMesh.draw(GL_LINES);
+}
+
+void SphereScene::drawVectors(const spherecamera &camera, const QList<Vector *> &vectors) {
+    for (auto &e : vectors) {
+        if (e->isTraceEnabled()) {
+            glEnable(GL_DEPTH_TEST);
+            TraceBuffer &buffer = traceBuffers[e];
+            buffer.sync(e->getTrace());
+            glLineWidth(2.5f);
+            buffer.draw(e->getTrace(), pixelsPerUnit(camera));
+            glDisable(GL_DEPTH_TEST);
+        }
+
+        if (e->isRotateVectorEnable()) {
+            glColor3f(0.0f, 0.0f, 1.0f);
+            glLineWidth(3.f);
+            glBegin(GL_LINES);
+            glVertex3f(e->rotateVector().x(), e->rotateVector().y(), e->rotateVector().z());
+            glVertex3f(-e->rotateVector().x(), -e->rotateVector().y(), -e->rotateVector().z());
+            glEnd();
+        }
+
+        glColor3f(e->getSelfColor().red, e->getSelfColor().green, e->getSelfColor().blue);
+        glLineWidth(2.5f);
+
+        glBegin(GL_LINES);
+        glVertex3f(0, 0, 0);
+
+        Vector3D vertex = e->getSpike().point;
+
+        glVertex3f(vertex.x(), vertex.y(), vertex.z());
+
+        glEnd();
+
+        glBegin(GL_LINES);
+
+        // arrowhead of the z axis turned to the vertex
+        for (auto &i : arrowheadOf(vertex)) {
+            glVertex3f(vertex.x(), vertex.y(), vertex.z());
+            glVertex3f(i.x(), i.y(), i.z());
+        }
+        glEnd();
+    }
+}
+
+// Back to front without a depth buffer: the sphere, the equator, the axes, then the traces and
+// the vectors over them
+void SphereScene::paint(QPainter *painter, const spherecamera &camera,
+                        const QList<Vector *> &vectors) {
+    QMatrix4x4 m = transform(camera);
+    auto       at = [&](const QVector3D &p) { return toWindow(m * p); };
+
+    painter->fillRect(0, 0, width, height, Qt::white);
+    painter->setRenderHint(QPainter::Antialiasing);
+
+    // An orthographic view shows the sphere as a disc whatever the camera
+    double radius = sphereRadius * pixelsPerUnit(camera);
+    painter->setPen(Qt::NoPen);
+    painter->setBrush(QColor::fromRgbF(0.85, 0.85, 0.85));
+    painter->drawEllipse(at(QVector3D()), radius, radius);
+
+    QPolygonF circle;
+    for (int i = 0; i < circleMesh.size(); ++i) {
+        circle << at(circleMesh.vertex(i));
+    }
+    painter->setPen(QPen(QColor::fromRgbF(0.6, 0.7, 0.7), 1.5));
+    painter->setBrush(QColor::fromRgbF(0.7, 0.8, 0.8));
+    painter->drawPolygon(circle);
+
+    painter->setPen(QPen(Qt::black, 2.3));
+    for (int i = 0; i + 1 < axisMesh.size(); i += 2) {
+        painter->drawLine(at(axisMesh.vertex(i)), at(axisMesh.vertex(i + 1)));
+    }
+
+    for (auto &e : vectors) {
+        if (e->isTraceEnabled()) {
+            paintTrace(painter, m, e->getTrace());
+        }
+
+        QVector3D vertex = toQVector3D(e->getSpike().point);
+        if (e->isRotateVectorEnable()) {
+            QVector3D axis = toQVector3D(e->rotateVector());
+            painter->setPen(QPen(Qt::blue, 3));
+            painter->drawLine(at(axis), at(-axis));
+        }
+
+        painter->setPen(QPen(toColor(e->getSelfColor()), 2.5));
+        painter->drawLine(at(QVector3D()), at(vertex));
+        for (auto &i : arrowheadOf(e->getSpike().point)) {
+            painter->drawLine(at(vertex), at(toQVector3D(i)));
+        }
+    }
+
+    paintLabels(painter, camera, vectors);
+}
+
+void SphereScene::paintLabels(QPainter *painter, const spherecamera &camera,
+                              const QList<Vector *> &vectors) const {
+    painter->setPen(Qt::black);
+    painter->setFont(font);
+    for (const scenelabel &label : labels(vectors)) {
+        painter->drawText(project(camera, label.point), label.text);
+    }
+}
+
+QVector<scenelabel> SphereScene::labels(const QList<Vector *> &vectors) const {
+    QVector<scenelabel> result;
+    result.append({Vector3D(0.0, 0.05, -1.2), "|1>"});
+    result.append({Vector3D(0.0, 0.05, 1.2), "|0>"});
+    result.append({Vector3D(axisSize + 0.1, 0.0, 0.0), "x"});
+    result.append({Vector3D(0.0, axisSize + 0.1, 0.0), "y"});
+    result.append({Vector3D(0.0, 0.0, axisSize + 0.1), "z"});
+    for (auto &e : vectors) {
+        if (e->isTraceEnabled()) {
+            result.append({Vector3D(1.2, -1.2, 1.2), e->getInfo()});
+        }
+    }
+    return result;
+}
+
+QPointF SphereScene::project(const spherecamera &camera, const Vector3D &p) const {
+    return toWindow(transform(camera) * toQVector3D(p));
+}
+
+QPointF SphereScene::toWindow(const QVector3D &ndc) const {
+    return QPointF((ndc.x() + 1) / 2 * width, (1 - ndc.y()) / 2 * height);
+}
+
+double SphereScene::pixelsPerUnit(const spherecamera &camera) const {
+    // resize() maps four units onto the shorter side
+    return qMin(width, height) / 4. * camera.scale;
+}
+
+// Same matrices as resize() and draw() give GL
+QMatrix4x4 SphereScene::transform(const spherecamera &camera) const {
+    QMatrix4x4 m;
+    GLfloat    ratio = static_cast<GLfloat>(height) / width;
+    if (width >= height) {
+        m.ortho(-2.0 / ratio, 2.0 / ratio, -2.0, 2.0, -10.0, 10.0);
+    } else {
+        m.ortho(-2.0, 2.0, -2.0 * ratio, 2.0 * ratio, -10.0, 10.0);
+    }
+    m.scale(camera.scale);
+    m.rotate(camera.xAngle, 1.0f, 0.0f, 0.0f);
+    m.rotate(camera.yAngle, 0.0f, 1.0f, 0.0f);
+    m.rotate(camera.zAngle, 0.0f, 0.0f, 1.0f);
+    return m;
+}
+
+// Segments shorter than a pixel are joined, as TraceBuffer::draw thins them out
+void SphereScene::paintTrace(QPainter *painter, const QMatrix4x4 &m, const Trace &trace) const {
+    const QVector<TraceVertex> &vertices = trace.vertices();
+    const QVector<int>         &runs = trace.runs();
+    auto at = [&](const TraceVertex &v) { return toWindow(m * QVector3D(v.x, v.y, v.z)); };
+
+    for (int i = 0; i < runs.size(); ++i) {
+        int     end = i + 1 < runs.size() ? runs[i + 1] : trace.size();
+        QPointF from = at(vertices[runs[i]]);
+        for (int k = runs[i] + 1; k < end; ++k) {
+            QPointF to = at(vertices[k]);
+            QPointF d = to - from;
+            if (k + 1 < end and d.x() * d.x() + d.y() * d.y() < 1) {
+                continue;
+            }
+            // The second vertex of a line gives its colour
+            painter->setPen(QPen(toColor(vertices[k].color), 2.5));
+            painter->drawLine(from, to);
+            from = to;
+        }
+    }
+}
@@ -0,0 +1,97 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#ifndef SPHERESCENE_HPP
+#define SPHERESCENE_HPP
+
+#include "Mesh.h"
+#include "TraceBuffer.h"
+#include "src/quantum/Vector.h"
+#include <QFont>
+#include <QHash>
+#include <QMatrix4x4>
+#include <QPainter>
+
+// Zoom and the rotations about x, y and z in degrees that the mouse gives the sphere
+struct spherecamera {
+    GLfloat scale;
+    GLfloat xAngle;
+    GLfloat yAngle;
+    GLfloat zAngle;
+};
+
+// Text written at a point of the scene
+struct scenelabel {
+    Vector3D point;
+    QString  text;
+};
+
+// The sphere, its axes and the vectors with their traces. The Sphere widget draws it into its
+// window and OffscreenRenderer into framebuffer objects, both with the fixed-function pipeline;
+// paint() draws the same picture with QPainter where there is no OpenGL. Text is left to the
+// caller as labels, since GL has no text of its own.
+class SphereScene {
+public:
+    SphereScene();
+
+    // Size of the window for paint() and project(); resize() sets it too
+    void setSize(int w, int h);
+
+    // Need the GL context to be current
+    void upload();
+    void destroy();
+    void destroyTrace(Vector *v);
+    void resize(int w, int h);
+    void draw(const spherecamera &camera, const QList<Vector *> &vectors);
+
+    void paint(QPainter *painter, const spherecamera &camera, const QList<Vector *> &vectors);
+    void paintLabels(QPainter *painter, const spherecamera &camera,
+                     const QList<Vector *> &vectors) const;
+
+    QVector<scenelabel> labels(const QList<Vector *> &vectors) const;
+    const QFont        &getFont() const { return font; }
+
+    // Position in the window of a point of the scene, y downwards
+    QPointF project(const spherecamera &camera, const Vector3D &p) const;
+    double  pixelsPerUnit(const spherecamera &camera) const;
+
+private:
+    const GLfloat sphereRadius = 1;
+    const GLfloat axisSize = 1.7f;
+    const QFont   font = QFont("System", 11);
+
+    int width = 1;
+    int height = 1;
+
+    QHash<Vector *, TraceBuffer> traceBuffers;
+
+    Mesh sphereMesh;
+    Mesh circleMesh;
+    Mesh axisMesh;
+
+    void       buildSphereMesh(int lats, int longs);
+    void       buildCircleMesh();
+    void       buildAxisMesh();
+    void       drawCircle();
+    void       drawAxis();
+    void       drawVectors(const spherecamera &camera, const QList<Vector *> &vectors);
+    void       paintTrace(QPainter *painter, const QMatrix4x4 &m, const Trace &trace) const;
+    QMatrix4x4 transform(const spherecamera &camera) const;
+    QPointF    toWindow(const QVector3D &ndc) const;
+};
+
+#endif // SPHERESCENE_HPP
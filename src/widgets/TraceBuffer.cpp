@@ -0,0 +1,132 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "TraceBuffer.h"
+#include <cstddef>
+
+namespace {
+const int VERTEX_SIZE = static_cast<int>(sizeof(TraceVertex));
+const int MIN_CAPACITY = 1024;
+} // namespace
+
+bool TraceBuffer::reserve(int count) {
+    if (count <= capacity) {
+        return true;
+    }
+    if (not buffer.isCreated()) {
+        if (not buffer.create()) {
+            return false;
+        }
+        buffer.setUsagePattern(QOpenGLBuffer::DynamicDraw);
+    }
+
+    int newCapacity = qMax(capacity, MIN_CAPACITY);
+    while (newCapacity < count) {
+        newCapacity *= 2;
+    }
+    buffer.bind();
+    buffer.allocate(newCapacity * VERTEX_SIZE);
+    buffer.release();
+    capacity = newCapacity;
+    uploaded = 0;
+    return true;
+}
+
+void TraceBuffer::sync(const Trace &trace) {
+    if (generation != trace.generation() or trace.size() < uploaded) {
+        generation = trace.generation();
+        uploaded = 0;
+    } else if (revision == trace.revision()) {
+        return;
+    }
+    if (trace.isEmpty() or not reserve(trace.size())) {
+        return;
+    }
+
+    // The last uploaded vertex may have been moved by a merge
+    int from = qMax(uploaded - 1, 0);
+    buffer.bind();
+    buffer.write(from * VERTEX_SIZE, trace.vertices().constData() + from,
+                 (trace.size() - from) * VERTEX_SIZE);
+    buffer.release();
+    uploaded = trace.size();
+    revision = trace.revision();
+}
+
+void TraceBuffer::destroy() {
+    buffer.destroy();
+    capacity = 0;
+    uploaded = 0;
+}
+
+void TraceBuffer::draw(const Trace &trace, double pixelsPerUnit) {
+    if (trace.isEmpty()) {
+        return;
+    }
+
+    // Without a buffer the same interleaved data is drawn from client memory
+    const bool  onGpu = buffer.isCreated() and uploaded == trace.size();
+    const char *base = nullptr;
+    if (onGpu) {
+        buffer.bind();
+    } else {
+        base = reinterpret_cast<const char *>(trace.vertices().constData());
+    }
+
+    // Skip vertices so that a drawn segment is about lodPixels long on screen
+    int    step = 1;
+    double lodPixels = Trace::getPolicy().lodPixels;
+    if (lodPixels > 0 and trace.countOfSegments() > 0 and trace.length() > 0) {
+        double segmentPixels = trace.length() / trace.countOfSegments() * pixelsPerUnit;
+        step = qMax(1, static_cast<int>(lodPixels / segmentPixels));
+    }
+
+    // The second vertex of a line gives its colour
+    glShadeModel(GL_FLAT);
+    glEnableClientState(GL_VERTEX_ARRAY);
+    glEnableClientState(GL_COLOR_ARRAY);
+
+    const QVector<int> &runs = trace.runs();
+    for (int i = 0; i < runs.size(); ++i) {
+        int start = runs[i];
+        int end = i + 1 < runs.size() ? runs[i + 1] : trace.size();
+        // Every step-th vertex, then the rest of the run at full detail so that it ends exactly
+        int sampled = (end - start - 1) / step;
+        if (step > 1 and sampled > 0) {
+            drawStrip(base, start, sampled + 1, step);
+            start += sampled * step;
+        }
+        drawStrip(base, start, end - start, 1);
+    }
+
+    glDisableClientState(GL_COLOR_ARRAY);
+    glDisableClientState(GL_VERTEX_ARRAY);
+    glShadeModel(GL_SMOOTH);
+
+    if (onGpu) {
+        buffer.release();
+    }
+}
+
+void TraceBuffer::drawStrip(const char *base, int first, int count, int step) {
+    if (count < 2) {
+        return;
+    }
+    const char *vertices = base + first * VERTEX_SIZE;
+    glVertexPointer(3, GL_FLOAT, step * VERTEX_SIZE, vertices + offsetof(TraceVertex, x));
+    glColorPointer(3, GL_FLOAT, step * VERTEX_SIZE, vertices + offsetof(TraceVertex, color));
+    glDrawArrays(GL_LINE_STRIP, 0, count);
+}
@@ -0,0 +1,47 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef TRACEBUFFER_HPP
+#define TRACEBUFFER_HPP
+
+#include "src/quantum/Trace.h"
+#include <QGLWidget>
+#include <QOpenGLBuffer>
+
+// GPU copy of a vector's Trace. sync() uploads only the vertices appended since the last call,
+// growing the buffer geometrically, so a long animation costs one small upload per frame. draw()
+// thins out segments that would be shorter than the policy's lodPixels on screen.
+class TraceBuffer {
+public:
+    TraceBuffer() : buffer(QOpenGLBuffer::VertexBuffer) {}
+
+    // All need the GL context to be current
+    void sync(const Trace &trace);
+    void destroy();
+    void draw(const Trace &trace, double pixelsPerUnit);
+
+private:
+    QOpenGLBuffer buffer;
+    int           capacity = 0;
+    int           uploaded = 0;
+    unsigned      generation = 0;
+    unsigned      revision = 0;
+
+    bool reserve(int count);
+    void drawStrip(const char *base, int first, int count, int step);
+};
+
+#endif // TRACEBUFFER_HPP
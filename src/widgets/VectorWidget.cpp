@@ -16,6 +16,7 @@
 
 #include "VectorWidget.h"
 #include "BlochDialog.h"
+#include "WidgetUtility.h"
 #include "src/quantum/UnitaryMatrix2x2.h"
 #include <QDoubleValidator>
 #include <QGridLayout>
@@ -235,7 +236,15 @@ void VectorWidget::updateComplexLineEdit(const QString &) {
     Utility::updateComplexLineEdit(betEd);
 }
 
+void VectorWidget::refreshFields() {
+    if (_v->getRevision() != filledRevision) {
+        fillFieldsOfVector(_v->getSpike());
+    }
+}
+
 void VectorWidget::fillFieldsOfVector(Spike sp, FIELD exclude) {
+    filledRevision = _v->getRevision();
+
     Vector v;
     v.changeVector(sp);
 
@@ -31,6 +31,8 @@ public:
 
     void    setAutoNormalise(bool f) { isAutoNormalize = f; }
     void    fillFieldsOfVector(Spike sp, FIELD exclude = FIELD::NOTHIN);
+    // Fills the fields only if the vector changed since they were last filled
+    void    refreshFields();
     Vector *getVector() { return _v; }
 
 signals:
@@ -44,8 +46,9 @@ public slots:
     void updateComplexLineEdit(const QString &);
 
 private:
-    Vector *_v = nullptr;
-    bool    isAutoNormalize = true;
+    Vector  *_v = nullptr;
+    bool     isAutoNormalize = true;
+    unsigned filledRevision = 0;
 
     QGridLayout *topLay = nullptr;
     QLineEdit   *theEd = nullptr;
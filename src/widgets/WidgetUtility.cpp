@@ -14,31 +14,23 @@
 // You should have received a copy of the GNU General Public License
 // along with this program.  If not, see <https://www.gnu.org/licenses/>.
 
-#ifndef CIRCUITOPERATOR_H
-#define CIRCUITOPERATOR_H
+#include "WidgetUtility.h"
 
-#include "src/quantum/Operator.h"
-#include <QComboBox>
+#include <QRegExp>
 
-enum OPERATORS { ID = 0, X, Y, Z, H, S, T, PHI, RX, RY, RZ };
-enum STATE { ACTIVE = 0, PASSIVE };
+namespace {
+QRegExpValidator
+    cmpVld(QRegExp(QString::fromUtf8("^[+-]?[0-9]*\\.?[0-9]*[+-]?[0-9]*\\.?[0-9]*[iIшШ]?$")));
+QRegExpValidator axsVld(QRegExp("^-?[\\d]*\\.?[\\d]*;?-?[\\d]*\\.?[\\d]*;?-?[\\d]*\\.?[\\d]*$"));
+} // namespace
 
-class CircuitOperator : public QComboBox {
-    Q_OBJECT
-public:
-    CircuitOperator(QWidget *parent, Operator op = Operator());
+namespace Utility {
+const QValidator *compValid() { return &cmpVld; }
+const QValidator *axisValid() { return &axsVld; }
 
-    QString   getOperatorName();
-    Operator &getOperator();
-    void      setState(STATE state);
+void updateComplexLineEdit(QLineEdit *lineEdit) {
+    QRegExp re(QString::fromUtf8("[IШш]"));
+    lineEdit->setText(lineEdit->text().replace(re, "i"));
+}
 
-public slots:
-    void slotOperatorChanged(int index);
-
-private:
-    Operator _op;
-    int      lastActivated = 0;
-    void     clearComboBoxNames();
-};
-
-#endif // CIRCUITOPERATOR_H
\ No newline at end of file
+} // namespace Utility
@@ -0,0 +1,30 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#ifndef WIDGETUTILITY_H
+#define WIDGETUTILITY_H
+
+#include "src/utility.h"
+#include <QLineEdit>
+#include <QRegExpValidator>
+
+namespace Utility {
+const QValidator *compValid();
+const QValidator *axisValid();
+
+void updateComplexLineEdit(QLineEdit *lineEdit);
+} // namespace Utility
+#endif // WIDGETUTILITY_H
@@ -0,0 +1,177 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "src/cli/BatchJob.h"
+#include "src/quantum/StateVector.h"
+#include <QBuffer>
+#include <QJsonArray>
+#include <gtest/gtest.h>
+
+namespace {
+// Parses the lines into job, false with the error of the first line or of check()
+bool parse(BatchJob *job, const QStringList &lines, QString *error) {
+    for (const QString &line : lines) {
+        if (not job->parseLine(line, error)) {
+            return false;
+        }
+    }
+    return job->check(error);
+}
+} // namespace
+
+TEST(BatchJob, validLines) {
+    BatchJob job("jobs:1", "queue");
+    QString  error;
+    ASSERT_TRUE(parse(&job, {"vector 1 0 0", "op H  # comment", "op Rx(90)", "op U(0,1,1,0)", ""},
+                      &error))
+        << error.toStdString();
+    EXPECT_EQ(1, job.countOfQubits());
+    EXPECT_EQ(3, job.paths(BatchJob::ZY).size());
+
+    BatchJob circuit;
+    ASSERT_TRUE(parse(&circuit, {"vector 0 1 0", "step H Id", "step X Rz(45)", "step Ctrl X"},
+                      &error))
+        << error.toStdString();
+    EXPECT_EQ(2, circuit.countOfQubits());
+    QVector<Vector3D> starts = circuit.startingVectors();
+    EXPECT_TRUE(Utility::fuzzyCompare(1., starts[0].y()));
+    EXPECT_TRUE(Utility::fuzzyCompare(1., starts[1].z()));
+    QVector<QVector<Path>> paths = circuit.paths(BatchJob::ZX);
+    ASSERT_EQ(3, paths.size());
+    EXPECT_EQ(2, paths[0].size());
+}
+
+TEST(BatchJob, opsAndStepsDoNotMix) {
+    BatchJob queue;
+    QString  error;
+    EXPECT_FALSE(parse(&queue, {"op H", "step H"}, &error));
+    EXPECT_FALSE(error.isEmpty());
+
+    BatchJob circuit;
+    error.clear();
+    EXPECT_FALSE(parse(&circuit, {"step H", "op H"}, &error));
+    EXPECT_FALSE(error.isEmpty());
+}
+
+TEST(BatchJob, stepsHaveEqualWidths) {
+    BatchJob job;
+    QString  error;
+    EXPECT_FALSE(parse(&job, {"step H Id", "step X"}, &error));
+    EXPECT_FALSE(error.isEmpty());
+
+    BatchJob vectors;
+    EXPECT_FALSE(parse(&vectors, {"vector 1 0 0", "vector 0 1 0", "step H"}, &error));
+}
+
+TEST(BatchJob, qubitLimit) {
+    QString step = "step";
+    for (int q = 0; q < StateVector::MAX_QUBITS; ++q) {
+        step += " Id";
+    }
+    BatchJob largest;
+    QString  error;
+    EXPECT_TRUE(parse(&largest, {step}, &error)) << error.toStdString();
+
+    BatchJob tooLarge;
+    EXPECT_FALSE(parse(&tooLarge, {step + " Id"}, &error));
+    EXPECT_FALSE(error.isEmpty());
+
+    // A joint state is kept only up to the limit of the window
+    QString joint = "step Ctrl";
+    for (int q = 1; q < CircuitState::MAX_JOINT_QUBITS; ++q) {
+        joint += " X";
+    }
+    BatchJob largestJoint;
+    error.clear();
+    EXPECT_TRUE(parse(&largestJoint, {joint}, &error)) << error.toStdString();
+    EXPECT_TRUE(largestJoint.checkAmplitudes(&error));
+
+    BatchJob tooLargeJoint;
+    EXPECT_FALSE(parse(&tooLargeJoint, {joint + " X"}, &error));
+    EXPECT_FALSE(error.isEmpty());
+    error.clear();
+    EXPECT_FALSE(largest.checkAmplitudes(&error));
+    EXPECT_FALSE(error.isEmpty());
+}
+
+TEST(BatchJob, runMatchesPaths) {
+    BatchJob job;
+    QString  error;
+    ASSERT_TRUE(parse(&job, {"vector 1 0 0", "step H Id", "step Ctrl X", "step Id Rz(45)"}, &error))
+        << error.toStdString();
+    QJsonObject            json = job.run(BatchJob::XY, false);
+    QVector<QVector<Path>> moves = job.paths(BatchJob::XY);
+    QJsonArray             trajectories = json["trajectories"].toArray();
+    ASSERT_EQ(2, trajectories.size());
+    for (int q = 0; q < 2; ++q) {
+        QJsonArray frames = trajectories[q].toArray();
+        QJsonArray last = frames[frames.size() - 1].toArray();
+        Vector3D   end = moves.last()[q].last().point;
+        EXPECT_TRUE(Utility::fuzzyCompare(end.x(), last[0].toDouble())) << "qubit " << q;
+        EXPECT_TRUE(Utility::fuzzyCompare(end.z(), last[2].toDouble())) << "qubit " << q;
+    }
+}
+
+TEST(BatchJob, malformedLines) {
+    const char *lines[] = {"op U(1,0,0)",      "op U(1,1,1,1)", "op U(1,0,0,1",  "op U1,0,0,1)",
+                           "op Rx(ninety)",    "op Rx",         "op H(90)",      "op Foo",
+                           "step H Foo",       "vector 0 0 0",  "vector 1 0",    "vector a b c",
+                           "unknown keyword"};
+    for (const char *line : lines) {
+        BatchJob job;
+        QString  error;
+        EXPECT_FALSE(job.parseLine(line, &error)) << line;
+        EXPECT_FALSE(error.isEmpty()) << line;
+    }
+}
+
+TEST(BatchJob, readerSplitsJobs) {
+    QByteArray text = "# no job yet\n"
+                      "\n"
+                      "vector 1 0 0\n"
+                      "op H\n"
+                      "job broken\n"
+                      "op Foo\n"
+                      "op H\n"
+                      "job circuit\n"
+                      "step H X\n"
+                      "job\n"
+                      "\n"
+                      "job last\n"
+                      "op X\n";
+    QBuffer buffer(&text);
+    ASSERT_TRUE(buffer.open(QIODevice::ReadOnly));
+    BatchReader reader(&buffer, "jobs");
+
+    QStringList names;
+    QStringList sources;
+    QStringList errors;
+    BatchJob    job;
+    QString     error;
+    while (reader.next(&job, &error)) {
+        names << job.getName();
+        sources << job.getSource();
+        errors << error;
+    }
+    EXPECT_EQ(QStringList({"", "broken", "circuit", "last"}), names);
+    EXPECT_EQ(QStringList({"jobs:1", "jobs:5", "jobs:8", "jobs:12"}), sources);
+    EXPECT_TRUE(errors[0].isEmpty());
+    EXPECT_EQ(QString("jobs:6: op needs a gate of the circuit menu or a unitary U(a,b,c,d)"),
+              errors[1]);
+    EXPECT_TRUE(errors[2].isEmpty());
+    EXPECT_TRUE(errors[3].isEmpty());
+}
@@ -0,0 +1,74 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/CircuitModel.h"
+#include <gtest/gtest.h>
+
+TEST(CircuitModel, resizeKeepsCells) {
+    CircuitModel circuit(2, 3);
+    circuit.setCell(1, 2, {CircuitModel::H, 0});
+    circuit.setCell(0, 1, {CircuitModel::RX, M_PI / 2});
+
+    circuit.resize(2, 5000);
+    EXPECT_EQ(CircuitModel::H, circuit.cell(1, 2).gate);
+    EXPECT_EQ(CircuitModel::ID, circuit.cell(1, 4999).gate);
+
+    circuit.resize(40, 5000);
+    EXPECT_EQ(CircuitModel::H, circuit.cell(1, 2).gate);
+    EXPECT_EQ(CircuitModel::RX, circuit.cell(0, 1).gate);
+    EXPECT_EQ(M_PI / 2, circuit.cell(0, 1).angle);
+    EXPECT_EQ(CircuitModel::ID, circuit.cell(39, 2).gate);
+
+    circuit.resize(1, 2);
+    EXPECT_EQ(CircuitModel::RX, circuit.cell(0, 1).gate);
+    EXPECT_EQ(1, circuit.countOfQubits());
+    EXPECT_EQ(2, circuit.countOfSteps());
+}
+
+TEST(CircuitModel, operators) {
+    CircuitModel circuit(3, 1);
+    circuit.setCell(0, 0, {CircuitModel::X, 0});
+    circuit.setCell(2, 0, {CircuitModel::RZ, M_PI / 2});
+
+    EXPECT_EQ(QString("X"), circuit.getOperator(0, 0).getOperatorName());
+    EXPECT_EQ(QString("Id"), circuit.getOperator(1, 0).getOperatorName());
+
+    QVector<UnitaryMatrix2x2> step = circuit.getStep(0);
+    ASSERT_EQ(3, step.size());
+    EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getX(), step[0]));
+    EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(UnitaryMatrix2x2::getS(), step[2]));
+
+    for (int g = CircuitModel::ID; g < CircuitModel::COUNT; ++g) {
+        EXPECT_FALSE(CircuitModel::gateName(g).isEmpty());
+        EXPECT_EQ(g, CircuitModel::findGate(CircuitModel::gateName(g)));
+    }
+    EXPECT_EQ(CircuitModel::RX, CircuitModel::findGate("rx"));
+    EXPECT_EQ(CircuitModel::COUNT, CircuitModel::findGate("CNOT"));
+    EXPECT_FALSE(CircuitModel::hasAngle(CircuitModel::CTRL));
+}
+
+TEST(CircuitModel, controls) {
+    CircuitModel circuit(3, 2);
+    EXPECT_FALSE(circuit.hasControls());
+    circuit.setCell(0, 1, {CircuitModel::CTRL, 0});
+    circuit.setCell(2, 1, {CircuitModel::X, 0});
+
+    EXPECT_TRUE(circuit.hasControls());
+    EXPECT_TRUE(circuit.getControls(0).isEmpty());
+    EXPECT_EQ(QVector<int>({0}), circuit.getControls(1));
+    // The control itself is the identity
+    EXPECT_EQ(QString("Id"), circuit.getOperator(0, 1).getOperatorName());
+}
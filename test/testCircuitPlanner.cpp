@@ -0,0 +1,142 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+
+#include "src/quantum/CircuitPlanner.h"
+#include "src/quantum/Vector.h"
+#include "src/utility.h"
+#include <gtest/gtest.h>
+
+namespace {
+CircuitModel randomCircuit(int qubits, int steps) {
+    CircuitModel circuit(qubits, steps);
+    for (int s = 0; s < steps; ++s) {
+        for (int q = 0; q < qubits; ++q) {
+            circuitcell c;
+            c.gate = static_cast<quint8>((q + 3 * s) % CircuitModel::COUNT);
+            c.angle = Utility::random(0., 2 * M_PI);
+            circuit.setCell(q, s, c);
+        }
+    }
+    return circuit;
+}
+
+bool comparePaths(const Path &expected, const Path &actual) {
+    if (expected.size() != actual.size()) {
+        return false;
+    }
+    for (int k = 0; k < expected.size(); ++k) {
+        Vector3D e = expected.frame(k).point;
+        Vector3D a = actual.frame(k).point;
+        if (not Utility::fuzzyCompare(e.x(), a.x()) or not Utility::fuzzyCompare(e.y(), a.y()) or
+            not Utility::fuzzyCompare(e.z(), a.z())) {
+            return false;
+        }
+    }
+    return true;
+}
+} // namespace
+
+TEST(CircuitPlanner, stepsMatchStateVector) {
+    const int      qubits = 3;
+    const int      steps = 6;
+    CircuitModel   circuit = randomCircuit(qubits, steps);
+    QVector<Spike> spikes;
+    for (int q = 0; q < qubits; ++q) {
+        double the = Utility::random(0., M_PI);
+        double phi = Utility::random(0., 2 * M_PI);
+        spikes.append(Vector::createSpike(the, phi));
+    }
+
+    CircuitPlanner planner;
+    planner.start(circuit, spikes, &Operator::applyZyDecomposition);
+
+    QVector<Vector3D> points;
+    for (const Spike &s : spikes) {
+        points.append(s.point);
+    }
+    // The circuit has CTRL cells, so the planner keeps a joint state too
+    ASSERT_TRUE(circuit.hasControls());
+    CircuitState state(points, true);
+    for (int s = 0; s < steps; ++s) {
+        // The decomposition changes halfway, as when a button is clicked during the animation
+        CircuitPlanner::Decomposition decomposition = &Operator::applyZyDecomposition;
+        if (s >= steps / 2) {
+            decomposition = &Operator::applyXyDecomposition;
+        }
+        circuitstep step = planner.takeStep(decomposition);
+        ASSERT_EQ(qubits, step.paths.size()) << "step " << s;
+
+        state.applyStep(circuit, s);
+        bool isControlled = not circuit.getControls(s).isEmpty();
+        for (int q = 0; q < qubits; ++q) {
+            Path expected = isControlled
+                                ? CircuitPlanner::turn(state.blochVector(q), spikes[q])
+                                : CircuitPlanner::move(circuit.getOperator(q, s), decomposition,
+                                                       state.blochVector(q), spikes[q]);
+            EXPECT_TRUE(comparePaths(expected, step.paths[q])) << "step " << s << " qubit " << q;
+            spikes[q] = expected.last();
+        }
+    }
+    EXPECT_TRUE(planner.takeStep(&Operator::applyZyDecomposition).paths.isEmpty());
+}
+
+TEST(CircuitPlanner, controlledStepsEndAtReducedVectors) {
+    // A CNOT, then X on the target alone
+    CircuitModel circuit(2, 2);
+    circuit.setCell(0, 0, {CircuitModel::CTRL, 0});
+    circuit.setCell(1, 0, {CircuitModel::X, 0});
+    circuit.setCell(1, 1, {CircuitModel::X, 0});
+
+    // The control at |0> leaves the target where it is all the way
+    CircuitPlanner planner;
+    planner.start(circuit, {Vector::createSpike(0, 0, 1), Vector::createSpike(0, 0, 1)},
+                  &Operator::applyZyDecomposition);
+    circuitstep step = planner.takeStep(&Operator::applyZyDecomposition);
+    ASSERT_EQ(2, step.paths.size());
+    for (int k = 0; k < step.paths[1].size(); ++k) {
+        Vector3D p = step.paths[1].frame(k).point;
+        EXPECT_NEAR(1, p.z(), 1e-9) << "frame " << k;
+    }
+    step = planner.takeStep(&Operator::applyZyDecomposition);
+    EXPECT_NEAR(-1, step.paths[1].last().point.z(), 1e-9);
+
+    // The control at |+> entangles the qubits, which shrink to the centre and stay there
+    planner.start(circuit, {Vector::createSpike(1, 0, 0), Vector::createSpike(0, 0, 1)},
+                  &Operator::applyZyDecomposition);
+    step = planner.takeStep(&Operator::applyZyDecomposition);
+    for (int q = 0; q < 2; ++q) {
+        const Path &path = step.paths[q];
+        EXPECT_NEAR(0, path.last().point.length(), 1e-9) << "qubit " << q;
+        EXPECT_NEAR(0.5, path.frame(path.size() / 2).point.length(), 0.05) << "qubit " << q;
+    }
+    step = planner.takeStep(&Operator::applyZyDecomposition);
+    for (int k = 0; k < step.paths[1].size(); ++k) {
+        EXPECT_NEAR(0, step.paths[1].frame(k).point.length(), 1e-9) << "frame " << k;
+    }
+}
+
+TEST(CircuitPlanner, restartDropsPlannedStep) {
+    CircuitPlanner planner;
+    planner.start(randomCircuit(2, 3), {Vector::createSpike(0, 0, 1), Vector::createSpike(1, 0, 0)},
+                  &Operator::applyZyDecomposition);
+    planner.takeStep(&Operator::applyZyDecomposition);
+
+    planner.start(randomCircuit(1, 1), {Vector::createSpike(0, 0, 1)},
+                  &Operator::applyZxDecomposition);
+    EXPECT_EQ(1, planner.takeStep(&Operator::applyZxDecomposition).paths.size());
+    EXPECT_TRUE(planner.takeStep(&Operator::applyZxDecomposition).paths.isEmpty());
+}
@@ -16,6 +16,8 @@
 
 #include "identityOperatorPairs.h"
 #include "src/quantum/Operator.h"
+#include <QHash>
+#include <cstring>
 #include <gtest/gtest.h>
 
 TEST(Operator, multiplicationIdentity) {
@@ -26,3 +28,180 @@ TEST(Operator, multiplicationIdentity) {
             << "Not equal pair: " << i;
     }
 }
+
+TEST(Operator, canonicalIgnoresPhase) {
+    for (int k = 0; k < 1000; ++k) {
+        quint64          seed = QRandomGenerator::global()->generate64();
+        UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(seed);
+        complex          phase = std::exp(C_I * QRandomGenerator::global()->bounded(2 * M_PI));
+        UnitaryMatrix2x2 phased;
+        ASSERT_TRUE(phased.updateMatrix({op.a() * phase, op.b() * phase, op.c() * phase,
+                                         op.d() * phase}));
+
+        EXPECT_TRUE(op == phased) << "Random operator seed: " << seed;
+        EXPECT_EQ(op.hash(), phased.hash()) << "Random operator seed: " << seed;
+        EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(op, phased));
+    }
+}
+
+TEST(Operator, canonicalDistinguishesGates) {
+    QHash<UnitaryMatrix2x2, int> gates;
+    for (int g = Gates::ID; g < Gates::COUNT; ++g) {
+        gates.insert(UnitaryMatrix2x2::getGate(g), g);
+        EXPECT_TRUE(UnitaryMatrix2x2::getGate(g) == UnitaryMatrix2x2::getGate(g));
+    }
+    EXPECT_EQ(Gates::COUNT, gates.size());
+
+    EXPECT_TRUE(UnitaryMatrix2x2::getXrotate(M_PI) == UnitaryMatrix2x2::getX());
+    EXPECT_TRUE(UnitaryMatrix2x2::getZrotate(M_PI / 2) == UnitaryMatrix2x2::getS());
+    EXPECT_FALSE(UnitaryMatrix2x2::getXrotate(M_PI / 2) == UnitaryMatrix2x2::getX());
+    EXPECT_EQ(QString("X"), Operator::getOperatorName(UnitaryMatrix2x2::getXrotate(M_PI)));
+    EXPECT_EQ(QString("U"), Operator::getOperatorName(UnitaryMatrix2x2::getXrotate(1.)));
+
+    // Keys of operators 2e-9 apart across a grid boundary differ
+    UnitaryMatrix2x2 low;
+    UnitaryMatrix2x2 high;
+    ASSERT_TRUE(low.updateMatrix({1, 0, 0, complex(1, 0.5e-6 - 1e-9)}));
+    ASSERT_TRUE(high.updateMatrix({1, 0, 0, complex(1, 0.5e-6 + 1e-9)}));
+    EXPECT_FALSE(low == high);
+    EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(low, high));
+}
+
+TEST(Operator, namesRoundedGates) {
+    UnitaryMatrix2x2 h;
+    ASSERT_TRUE(h.updateMatrix({0.70711, 0.70711, 0.70711, -0.70711}));
+    EXPECT_EQ(QString("H"), Operator::getOperatorName(h));
+
+    // Noise far below the tolerance that straddles a grid boundary of the keys
+    UnitaryMatrix2x2 low;
+    UnitaryMatrix2x2 high;
+    ASSERT_TRUE(low.updateMatrix({1, 0, 0, complex(1, 0.5e-6 - 1e-9)}));
+    ASSERT_TRUE(high.updateMatrix({1, 0, 0, complex(1, 0.5e-6 + 1e-9)}));
+    EXPECT_EQ(QString("Id"), Operator::getOperatorName(low));
+    EXPECT_EQ(QString("Id"), Operator::getOperatorName(high));
+}
+
+TEST(Operator, decompositionCache) {
+    Operator::clearCache();
+    UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(12345);
+    complex          phase = std::exp(C_I * 1.234);
+    UnitaryMatrix2x2 phased;
+    ASSERT_TRUE(
+        phased.updateMatrix({op.a() * phase, op.b() * phase, op.c() * phase, op.d() * phase}));
+
+    Operator first;
+    first.setOperator(op);
+    Operator second;
+    second.setOperator(phased);
+
+    decomposition dec = first.zyDecomposition();
+    EXPECT_EQ(0u, Operator::getCacheStatistics().hits);
+    EXPECT_EQ(1u, Operator::getCacheStatistics().misses);
+    first.zyDecomposition();
+    decomposition phasedDec = second.zyDecomposition();
+    EXPECT_EQ(2u, Operator::getCacheStatistics().hits);
+    EXPECT_EQ(1u, Operator::getCacheStatistics().misses);
+
+    // The cached decomposition keeps the phase of the operator that asked for it
+    matrix2x2 expected = Operator::getMatrixByZyDec(dec);
+    matrix2x2 actual = Operator::getMatrixByZyDec(phasedDec);
+    EXPECT_TRUE(Utility::fuzzyCompare(expected.a * phase, actual.a));
+    EXPECT_TRUE(Utility::fuzzyCompare(expected.b * phase, actual.b));
+    EXPECT_TRUE(Utility::fuzzyCompare(expected.c * phase, actual.c));
+    EXPECT_TRUE(Utility::fuzzyCompare(expected.d * phase, actual.d));
+
+    first.vectorAngleDec();
+    second.vectorAngleDec();
+    first.toH();
+    first.zxDecomposition();
+    EXPECT_EQ(3u, Operator::getCacheStatistics().hits);
+    EXPECT_EQ(2u, Operator::getCacheStatistics().misses);
+
+    Operator::setCacheCapacity(1);
+    for (int k = 0; k < 4; ++k) {
+        first.setOperator(Operator::genRandUnitaryMatrix(k + 1));
+        first.xyDecomposition();
+    }
+    EXPECT_EQ(1, Operator::getCacheStatistics().size);
+    Operator::setCacheCapacity(1024);
+    Operator::clearCache();
+}
+
+TEST(Operator, decompositionCacheRepeats) {
+    Operator::clearCache();
+    decomposition (Operator::*getDec[])() = {
+        &Operator::zxDecomposition, &Operator::zyDecomposition, &Operator::xyDecomposition,
+        &Operator::zyxDecomposition};
+    for (int k = 1; k <= 100; ++k) {
+        UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(k);
+        complex          phase = std::exp(C_I * (0.1 * k));
+        UnitaryMatrix2x2 phased;
+        ASSERT_TRUE(
+            phased.updateMatrix({op.a() * phase, op.b() * phase, op.c() * phase, op.d() * phase}));
+        Operator o;
+        o.setOperator(phased);
+
+        // The first call misses the cache and the second one hits it
+        for (auto f : getDec) {
+            decomposition miss = (o.*f)();
+            decomposition hit = (o.*f)();
+            EXPECT_EQ(0, memcmp(&miss, &hit, sizeof(decomposition))) << "operator seed " << k;
+        }
+    }
+    Operator::clearCache();
+}
+
+TEST(Operator, quaternionRoundTrip) {
+    for (int k = 1; k <= 1000; ++k) {
+        UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(k);
+        Quaternion       q = op.toQuaternion();
+        EXPECT_LE(0., q.scalar());
+        EXPECT_TRUE(Utility::fuzzyCompare(1., q.length()));
+        EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(op, UnitaryMatrix2x2::fromQuaternion(q)))
+            << "Random operator seed: " << k;
+
+        UnitaryMatrix2x2 other = Operator::genRandUnitaryMatrix(k + 1000);
+        EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(
+            op * other, UnitaryMatrix2x2::fromQuaternion(q * other.toQuaternion())))
+            << "Random operator seed: " << k;
+    }
+
+    for (int g = Gates::ID; g < Gates::COUNT; ++g) {
+        vectorangle va = Operator::vectorAngleDec(UnitaryMatrix2x2::getGate(g));
+        EXPECT_TRUE(Utility::fuzzyCompare(Gates::TABLE[g].axisAngle[0], va.x));
+        EXPECT_TRUE(Utility::fuzzyCompare(Gates::TABLE[g].axisAngle[1], va.y));
+        EXPECT_TRUE(Utility::fuzzyCompare(Gates::TABLE[g].axisAngle[2], va.z));
+        EXPECT_TRUE(Utility::fuzzyCompare(Gates::TABLE[g].axisAngle[3], va.angle));
+    }
+}
+
+TEST(Operator, quaternionSlerp) {
+    Quaternion q = UnitaryMatrix2x2::getZrotate(M_PI / 2).toQuaternion();
+    Quaternion half = Quaternion::slerp(Quaternion(), q, 0.5);
+    Vector3D   axis;
+    double     angle = 0;
+    half.getAxisAndAngle(&axis, &angle);
+    EXPECT_TRUE(Utility::fuzzyCompare(45., angle));
+    EXPECT_TRUE(Utility::fuzzyCompare(1., axis.z()));
+}
+
+TEST(Operator, fuse) {
+    Operator h, z, s;
+    h.toH();
+    z.toZ();
+    s.toS();
+    EXPECT_EQ(QString("X"), Operator::fuse({h, z, h}).getOperatorName());
+    EXPECT_EQ(QString("Z"), Operator::fuse({s, s}).getOperatorName());
+    EXPECT_EQ(QString("Id"), Operator::fuse({}).getOperatorName());
+
+    for (int k = 1; k <= 100; ++k) {
+        QVector<Operator> ops(3);
+        UnitaryMatrix2x2  expected;
+        for (int i = 0; i < ops.size(); ++i) {
+            ops[i].setOperator(Operator::genRandUnitaryMatrix(k * 3 + i));
+            expected = ops[i].getOperator() * expected;
+        }
+        EXPECT_TRUE(
+            UnitaryMatrix2x2::compareOperators(expected, Operator::fuse(ops).getOperator()));
+    }
+}
@@ -17,9 +17,23 @@
 #include "src/quantum/Operator.h"
 #include "unitaryOperators.h"
 #include <QMap>
+#include <cstring>
 #include <gtest/gtest.h>
 #include <qglobal.h>
 
+// Selects an engine for the scope and restores the previous one, also when an assertion returns
+class EngineGuard {
+public:
+    explicit EngineGuard(DecompositionKernel::ENGINE engine)
+        : previous_(DecompositionKernel::getEngine()) {
+        DecompositionKernel::setEngine(engine);
+    }
+    ~EngineGuard() { DecompositionKernel::setEngine(previous_); }
+
+private:
+    DecompositionKernel::ENGINE previous_;
+};
+
 UnitaryMatrix2x2 checkMatrixDecomposition(UnitaryMatrix2x2 op,
                                           decomposition (*getDec)(UnitaryMatrix2x2),
                                           matrix2x2(getMatrix)(decomposition)) {
@@ -100,3 +114,128 @@ TEST(Operator, vectorAngleStatic) {
             << "Not equal; test case number " << k << "\n\n";
     }
 }
+
+void batchTestDecomposition(DecompositionKernel::KIND kind,
+                            decomposition (*getDec)(UnitaryMatrix2x2)) {
+    QVector<UnitaryMatrix2x2> ops = unitaryOperators2x2();
+    int                       randomCnt = 10000;
+    for (int k = 0; k < randomCnt; ++k) {
+        ops.append(Operator::genRandUnitaryMatrix(QRandomGenerator::global()->generate64()));
+    }
+
+    std::size_t     n = ops.size();
+    QVector<double> re[4], im[4], dec[4];
+    for (int j = 0; j < 4; ++j) {
+        re[j].resize(n);
+        im[j].resize(n);
+        dec[j].resize(n);
+    }
+    for (std::size_t k = 0; k < n; ++k) {
+        complex m[4] = {ops[k].a(), ops[k].b(), ops[k].c(), ops[k].d()};
+        for (int j = 0; j < 4; ++j) {
+            re[j][k] = m[j].real();
+            im[j][k] = m[j].imag();
+        }
+    }
+
+    matrix2x2batch     batch = {re[0].constData(), im[0].constData(), re[1].constData(),
+                                im[1].constData(), re[2].constData(), im[2].constData(),
+                                re[3].constData(), im[3].constData()};
+    decompositionbatch decs = {dec[0].data(), dec[1].data(), dec[2].data(), dec[3].data()};
+
+    DecompositionKernel::ENGINE engines[] = {DecompositionKernel::LEGACY,
+                                             DecompositionKernel::FAST};
+    for (DecompositionKernel::ENGINE engine : engines) {
+        EngineGuard guard(engine);
+        DecompositionKernel::decompose(kind, batch, decs, n);
+
+        for (std::size_t k = 0; k < n; ++k) {
+            decomposition expected = getDec(ops[k]);
+            // bitwise comparison: the batch must reproduce the scalar result exactly
+            EXPECT_EQ(0, memcmp(&expected.alpha, &decs.alpha[k], sizeof(double)))
+                << "alpha differs; engine " << engine << "; operator number " << k << "\n\n";
+            EXPECT_EQ(0, memcmp(&expected.beta, &decs.beta[k], sizeof(double)))
+                << "beta differs; engine " << engine << "; operator number " << k << "\n\n";
+            EXPECT_EQ(0, memcmp(&expected.delta, &decs.delta[k], sizeof(double)))
+                << "delta differs; engine " << engine << "; operator number " << k << "\n\n";
+            EXPECT_EQ(0, memcmp(&expected.gamma, &decs.gamma[k], sizeof(double)))
+                << "gamma differs; engine " << engine << "; operator number " << k << "\n\n";
+        }
+    }
+}
+
+TEST(Operator, zxDecompositionBatch) {
+    batchTestDecomposition(DecompositionKernel::ZX, Operator::zxDecomposition);
+}
+
+TEST(Operator, zyDecompositionBatch) {
+    batchTestDecomposition(DecompositionKernel::ZY, Operator::zyDecomposition);
+}
+
+TEST(Operator, xyDecompositionBatch) {
+    batchTestDecomposition(DecompositionKernel::XY, Operator::xyDecomposition);
+}
+
+TEST(Operator, zyxDecompositionBatch) {
+    batchTestDecomposition(DecompositionKernel::ZYX, Operator::zyxDecomposition);
+}
+
+TEST(Operator, zxDecompositionFast) {
+    EngineGuard guard(DecompositionKernel::FAST);
+    staticTestDecomposition(Operator::zxDecomposition, Operator::getMatrixByZxDec);
+    randomTestDecomposition(Operator::zxDecomposition, Operator::getMatrixByZxDec);
+}
+
+TEST(Operator, zyDecompositionFast) {
+    EngineGuard guard(DecompositionKernel::FAST);
+    staticTestDecomposition(Operator::zyDecomposition, Operator::getMatrixByZyDec);
+    randomTestDecomposition(Operator::zyDecomposition, Operator::getMatrixByZyDec);
+}
+
+TEST(Operator, xyDecompositionFast) {
+    EngineGuard guard(DecompositionKernel::FAST);
+    staticTestDecomposition(Operator::xyDecomposition, Operator::getMatrixByXyDec);
+    randomTestDecomposition(Operator::xyDecomposition, Operator::getMatrixByXyDec);
+}
+
+TEST(Operator, zyxDecompositionFast) {
+    EngineGuard guard(DecompositionKernel::FAST);
+    staticTestDecomposition(Operator::zyxDecomposition, Operator::getMatrixByZyxDec);
+    randomTestDecomposition(Operator::zyxDecomposition, Operator::getMatrixByZyxDec);
+}
+
+TEST(Decomposition, gateTable) {
+    matrix2x2 (*getMatrix[])(decomposition) = {
+        Operator::getMatrixByZxDec, Operator::getMatrixByZyDec, Operator::getMatrixByXyDec,
+        Operator::getMatrixByZyxDec};
+    DecompositionKernel::KIND kinds[] = {DecompositionKernel::ZX, DecompositionKernel::ZY,
+                                         DecompositionKernel::XY, DecompositionKernel::ZYX};
+
+    for (int g = Gates::ID; g < Gates::COUNT; ++g) {
+        UnitaryMatrix2x2 op = UnitaryMatrix2x2::getGate(g);
+        EXPECT_TRUE(UnitaryMatrix2x2::isUnitaryMatrix(op)) << Gates::TABLE[g].name;
+        EXPECT_EQ(Gates::TABLE[g].name, Operator::getOperatorName(op).toStdString());
+
+        for (int k = 0; k < 4; ++k) {
+            decomposition dec = Gates::getDecomposition(static_cast<Gates::GATE>(g), kinds[k]);
+            for (double angle : {dec.alpha, dec.beta, dec.delta, dec.gamma}) {
+                EXPECT_TRUE(angle > -M_PI and angle <= M_PI)
+                    << Gates::TABLE[g].name << ", decomposition " << k;
+            }
+            UnitaryMatrix2x2 actual;
+            actual.updateMatrix(getMatrix[k](dec));
+            EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(op, actual))
+                << Gates::TABLE[g].name << ", decomposition " << k;
+        }
+
+        const double *axisAngle = Gates::TABLE[g].axisAngle;
+        vectorangle   va;
+        va.x = axisAngle[0];
+        va.y = axisAngle[1];
+        va.z = axisAngle[2];
+        va.angle = axisAngle[3];
+        UnitaryMatrix2x2 actual;
+        actual.updateMatrix(Operator::getMatrixByVecAng(va));
+        EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(op, actual)) << Gates::TABLE[g].name;
+    }
+}
@@ -0,0 +1,162 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/Operator.h"
+#include <gtest/gtest.h>
+
+bool comparePoints(const Vector3D &p1, const Vector3D &p2) {
+    return Utility::fuzzyCompare(p1.x(), p2.x()) and Utility::fuzzyCompare(p1.y(), p2.y()) and
+           Utility::fuzzyCompare(p1.z(), p2.z());
+}
+
+TEST(Path, singleFrame) {
+    Spike s = Vector::createSpike(M_PI / 3, M_PI / 4);
+    Path  path(s);
+    EXPECT_EQ(1, path.size());
+    EXPECT_TRUE(comparePoints(s.point, path.frame(0).point));
+    EXPECT_TRUE(comparePoints(s.point, path.last().point));
+    EXPECT_TRUE(Path().isEmpty());
+}
+
+TEST(Path, rotationFrames) {
+    Spike    s = Vector::createSpike(1.0, 0.0, 0.0);
+    Vector3D axis(0, 0, 1);
+    Path     path = Operator::rotate(s, axis, M_PI / 2);
+    int      frames = static_cast<int>(Utility::getDuration());
+
+    ASSERT_EQ(frames + 1, path.size());
+    EXPECT_TRUE(comparePoints(s.point, path.frame(0).point));
+    EXPECT_TRUE(comparePoints(Vector3D(0, 1, 0), path.last().point));
+    for (int k = 0; k < path.size(); ++k) {
+        double   angle = static_cast<double>(k) / frames * 90;
+        Vector3D expected = Quaternion::fromAxisAndAngle(axis, angle).rotatedVector(s.point);
+        EXPECT_TRUE(comparePoints(expected, path.frame(k).point)) << "frame " << k;
+    }
+}
+
+TEST(Path, turnFrames) {
+    Path     path(Vector::createSpike(1.0, 0.0, 0.0));
+    Vector3D end(0, 0, 0.5);
+    path.addTurn(Vector::createSpike(end.x(), end.y(), end.z()));
+
+    ASSERT_EQ(static_cast<int>(Utility::getDuration()) + 1, path.size());
+    EXPECT_TRUE(comparePoints(end, path.last().point));
+    Vector3D middle = path.frameAt((path.size() - 1) / 2.).point;
+    EXPECT_TRUE(comparePoints(0.75 * Vector3D(1, 0, 1).normalized(), middle));
+
+    // From the centre the vector grows along the direction of the end
+    Path grow(Vector::createSpike(0.0, 0.0, 0.0));
+    grow.addTurn(Vector::createSpike(0.0, -1.0, 0.0));
+    EXPECT_TRUE(comparePoints(Vector3D(0, -0.5, 0), grow.frameAt((grow.size() - 1) / 2.).point));
+
+    // Opposite directions still turn
+    Path flip(Vector::createSpike(0.0, 0.0, 1.0));
+    flip.addTurn(Vector::createSpike(0.0, 0.0, -1.0));
+    EXPECT_TRUE(comparePoints(Vector3D(0, 0, -1), flip.last().point));
+    EXPECT_TRUE(Utility::fuzzyCompare(1., flip.frameAt((flip.size() - 1) / 2.).point.length()));
+}
+
+TEST(Path, decompositionsEndTogether) {
+    for (int k = 1; k <= 100; ++k) {
+        UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(k);
+        Spike    s = Vector::createSpike(Utility::random(0., M_PI), Utility::random(0., 2 * M_PI));
+        Vector3D expected = Operator::applyVectorRotation(s, op).last().point;
+
+        Path paths[] = {Operator::applyZxDecomposition(s, op),
+                        Operator::applyZyDecomposition(s, op),
+                        Operator::applyXyDecomposition(s, op),
+                        Operator::applyZyxDecomposition(s, op),
+                        Operator::applyOperator(s, op)};
+        for (auto &path : paths) {
+            EXPECT_TRUE(comparePoints(s.point, path.frame(0).point)) << "operator seed " << k;
+            EXPECT_TRUE(comparePoints(expected, path.last().point)) << "operator seed " << k;
+            for (int i = 0; i < path.size(); ++i) {
+                EXPECT_TRUE(Utility::fuzzyCompare(1., path.frame(i).point.length()));
+            }
+        }
+    }
+}
+
+TEST(Path, vectorPlaysEveryFrame) {
+    Vector v(0., 0.);
+    Path   path = Operator::rXRotate(v.getSpike(), M_PI);
+    v.changeVector(path);
+    v.setAnimateState(true);
+
+    int steps = 0;
+    while (v.isNowAnimate()) {
+        EXPECT_TRUE(comparePoints(path.frame(qMin(steps, path.size() - 1)).point,
+                                  v.getSpike().point));
+        v.takeStep();
+        ++steps;
+    }
+    EXPECT_EQ(path.size() + 1, steps);
+    EXPECT_GE(path.size() - 1, v.getTrace().countOfSegments());
+    EXPECT_LT(0, v.getTrace().countOfSegments());
+    EXPECT_TRUE(comparePoints(path.last().point, v.getSpike().point));
+}
+
+TEST(Path, fractionalFrames) {
+    Spike s = Vector::createSpike(1.0, 0.0, 0.0);
+    Path  path = Operator::rotate(s, Vector3D(0, 0, 1), M_PI / 2);
+    for (int i = 0; i < path.size(); ++i) {
+        EXPECT_TRUE(comparePoints(path.frame(i).point, path.frameAt(i).point));
+    }
+    EXPECT_TRUE(comparePoints(path.last().point, path.frameAt(path.size() + 10.).point));
+
+    // Halfway between two frames of a single rotation is halfway in angle
+    Vector3D mid = path.frameAt(0.5).point;
+    double   step = M_PI / 2 / (path.size() - 1);
+    EXPECT_TRUE(comparePoints(Vector3D(std::cos(step / 2), std::sin(step / 2), 0), mid));
+}
+
+TEST(Path, vectorAdvancesByElapsedFrames) {
+    Vector v(0., 0.);
+    Path   path = Operator::rXRotate(v.getSpike(), M_PI);
+    v.changeVector(path);
+    v.setAnimateState(true);
+
+    // 2.5 frames a step reach the end in ceil((size - 1) / 2.5) steps
+    int steps = 0;
+    while (v.hasPath()) {
+        v.advance(2.5);
+        ++steps;
+    }
+    EXPECT_EQ(static_cast<int>(std::ceil((path.size() - 1) / 2.5)) + 1, steps);
+    EXPECT_TRUE(comparePoints(path.last().point, v.getSpike().point));
+    EXPECT_TRUE(v.isNowAnimate());
+    v.advance(2.5);
+    EXPECT_FALSE(v.isNowAnimate());
+}
+
+TEST(Path, vectorRevisionFollowsChanges) {
+    Vector   v(0., 0.);
+    unsigned revision = v.getRevision();
+    v.getSpike();
+    v.getTrace();
+    EXPECT_EQ(revision, v.getRevision());
+
+    v.changeVector(Operator::rXRotate(v.getSpike(), M_PI));
+    EXPECT_NE(revision, v.getRevision());
+
+    revision = v.getRevision();
+    v.advance(1.);
+    EXPECT_NE(revision, v.getRevision());
+
+    revision = v.getRevision();
+    v.setTraceColor(Color::RED);
+    EXPECT_NE(revision, v.getRevision());
+}
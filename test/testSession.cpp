@@ -0,0 +1,147 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/Session.h"
+#include <QDir>
+#include <cstring>
+#include <gtest/gtest.h>
+
+namespace {
+QString sessionFile() { return QDir::tempPath() + "/blochsphere-testSession.bloch"; }
+} // namespace
+
+TEST(Session, roundTrip) {
+    Vector v(0., 0.);
+    v.setName("q0");
+    v.setTraceColor(Color::YELLOW);
+    v.setEnableTrace(false);
+    Operator op;
+    op.toH();
+    v.changeVector(op.applyZyDecomposition(v.getSpike()));
+    while (v.hasPath()) {
+        v.takeStep();
+    }
+    ASSERT_FALSE(v.getTrace().isEmpty());
+
+    QVector<Operator> queue(2);
+    queue[0].toS();
+    queue[1].setOperator(Operator::genRandUnitaryMatrix(7), "U");
+
+    CircuitModel circuit(2, 3);
+    circuit.setCell(1, 2, {CircuitModel::RX, 0.25});
+    circuit.setCell(0, 1, {CircuitModel::H, 0});
+
+    {
+        SessionWriter writer(sessionFile());
+        ASSERT_TRUE(writer.isOpen());
+        EXPECT_TRUE(writer.writeVector(v));
+        EXPECT_TRUE(writer.writeVector(Vector(1., 0., 0.)));
+        EXPECT_TRUE(writer.writeQueue(queue));
+        EXPECT_TRUE(writer.writeCircuit(circuit));
+        EXPECT_TRUE(writer.commit());
+    }
+
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(sessionFile())) << reader.errorString().toStdString();
+    ASSERT_EQ(2, reader.getVectors().size());
+
+    const sessionvector &saved = reader.getVectors()[0];
+    EXPECT_EQ(QString("q0"), saved.name);
+    EXPECT_EQ(v.getSpike().point.z(), saved.point.z());
+    EXPECT_EQ(Color::YELLOW.green, saved.traceColor.green);
+    EXPECT_FALSE(saved.traceEnabled);
+
+    tracearrays arrays = v.getTrace().arrays();
+    ASSERT_EQ(arrays.countOfVertices, saved.trace.countOfVertices);
+    ASSERT_EQ(arrays.countOfRuns, saved.trace.countOfRuns);
+    EXPECT_EQ(0, std::memcmp(arrays.vertices, saved.trace.vertices,
+                             arrays.countOfVertices * sizeof(TraceVertex)));
+    EXPECT_EQ(arrays.runs[0], saved.trace.runs[0]);
+    EXPECT_EQ(arrays.length, saved.trace.length);
+    EXPECT_EQ(0, reader.getVectors()[1].trace.countOfVertices);
+
+    Vector   restored;
+    unsigned generation = restored.getTrace().generation();
+    restored.assignTrace(saved.trace);
+    EXPECT_EQ(v.getTrace().size(), restored.getTrace().size());
+    EXPECT_NE(generation, restored.getTrace().generation());
+
+    ASSERT_EQ(2, reader.getQueue().size());
+    Operator s = reader.getQueue()[0];
+    Operator u = reader.getQueue()[1];
+    EXPECT_EQ(QString("S"), s.getOperatorName());
+    EXPECT_TRUE(UnitaryMatrix2x2::compareOperators(queue[1].getOperator(), u.getOperator()));
+
+    ASSERT_TRUE(reader.hasCircuit());
+    EXPECT_EQ(2, reader.getCircuit().countOfQubits());
+    EXPECT_EQ(3, reader.getCircuit().countOfSteps());
+    EXPECT_EQ(CircuitModel::RX, reader.getCircuit().cell(1, 2).gate);
+    EXPECT_EQ(0.25, reader.getCircuit().cell(1, 2).angle);
+    EXPECT_EQ(CircuitModel::H, reader.getCircuit().cell(0, 1).gate);
+}
+
+TEST(Session, rejectsMalformedFiles) {
+    SessionReader reader;
+    EXPECT_FALSE(reader.open(QDir::tempPath() + "/blochsphere-testSession-missing.bloch"));
+
+    {
+        QFile file(sessionFile());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        file.write(QByteArray("not a session file", 18));
+    }
+    EXPECT_FALSE(reader.open(sessionFile()));
+
+    // A chunk that claims more bytes than the file has
+    {
+        QFile file(sessionFile());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QByteArray head("BLOCHSES\x01\0\0\0\0\0\0\0VECT\0\0\0\0\xff\0\0\0\0\0\0\0", 32);
+        file.write(head);
+    }
+    EXPECT_FALSE(reader.open(sessionFile()));
+    EXPECT_TRUE(reader.getVectors().isEmpty());
+
+    // A circuit without qubits but with steps
+    {
+        QFile file(sessionFile());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+        QByteArray head("BLOCHSES\x01\0\0\0\0\0\0\0CIRC\0\0\0\0\x08\0\0\0\0\0\0\0"
+                        "\0\0\0\0\xff\xff\xff\xff",
+                        40);
+        file.write(head);
+    }
+    EXPECT_FALSE(reader.open(sessionFile()));
+    EXPECT_FALSE(reader.hasCircuit());
+}
+
+TEST(Session, uncommittedWriterKeepsFile) {
+    {
+        SessionWriter writer(sessionFile());
+        ASSERT_TRUE(writer.isOpen());
+        EXPECT_TRUE(writer.writeCircuit(CircuitModel(1, 1)));
+        EXPECT_TRUE(writer.commit());
+    }
+    {
+        SessionWriter writer(sessionFile());
+        ASSERT_TRUE(writer.isOpen());
+        EXPECT_TRUE(writer.writeCircuit(CircuitModel(2, 3)));
+    }
+
+    SessionReader reader;
+    ASSERT_TRUE(reader.open(sessionFile())) << reader.errorString().toStdString();
+    ASSERT_TRUE(reader.hasCircuit());
+    EXPECT_EQ(1, reader.getCircuit().countOfQubits());
+}
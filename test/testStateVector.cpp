@@ -0,0 +1,126 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/CircuitState.h"
+#include "src/quantum/Operator.h"
+#include "src/quantum/StateVector.h"
+#include <gtest/gtest.h>
+
+bool compareVectors(const Vector3D &expected, const Vector3D &actual) {
+    return Utility::fuzzyCompare(expected.x(), actual.x()) and
+           Utility::fuzzyCompare(expected.y(), actual.y()) and
+           Utility::fuzzyCompare(expected.z(), actual.z());
+}
+
+TEST(StateVector, singleQubitFollowsSphere) {
+    for (int k = 1; k <= 100; ++k) {
+        UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(k);
+        Spike    s = Vector::createSpike(Utility::random(0., M_PI), Utility::random(0., 2 * M_PI));
+        Vector3D expected = Operator::applyVectorRotation(s, op).last().point;
+
+        StateVector state = StateVector::fromBlochVectors({s.point});
+        EXPECT_TRUE(compareVectors(s.point, state.blochVector(0))) << "operator seed " << k;
+        state.apply(0, op);
+        EXPECT_TRUE(compareVectors(expected, state.blochVector(0))) << "operator seed " << k;
+    }
+}
+
+TEST(StateVector, productStateKeepsQubits) {
+    const int                 n = 16;
+    QVector<Vector3D>         points;
+    QVector<Vector3D>         expected;
+    QVector<UnitaryMatrix2x2> ops;
+    for (int k = 0; k < n; ++k) {
+        Spike s = Vector::createSpike(Utility::random(0., M_PI), Utility::random(0., 2 * M_PI));
+        UnitaryMatrix2x2 op = Operator::genRandUnitaryMatrix(k + 1);
+        points.append(s.point);
+        ops.append(op);
+        expected.append(Operator::applyVectorRotation(s, op).last().point);
+    }
+
+    // Large enough to be split between threads
+    int threads = StateVector::getThreadCount();
+    StateVector::setThreadCount(4);
+    StateVector state = StateVector::fromBlochVectors(points);
+    state.applyStep(ops);
+    StateVector::setThreadCount(threads);
+    EXPECT_TRUE(Utility::fuzzyCompare(1., state.norm()));
+    for (int k = 0; k < n; ++k) {
+        EXPECT_TRUE(compareVectors(expected[k], state.blochVector(k))) << "qubit " << k;
+    }
+}
+
+TEST(StateVector, entangledQubitIsMixed) {
+    // (|00> + |11>) / sqrt(2)
+    StateVector state(2);
+    state.apply(0, UnitaryMatrix2x2::getH());
+    EXPECT_TRUE(compareVectors(Vector3D(1, 0, 0), state.blochVector(0)));
+    state.applyControlled(0, 1, UnitaryMatrix2x2::getX());
+
+    EXPECT_TRUE(Utility::fuzzyCompare(M_SQRT1_2, state.amplitude(0).real()));
+    EXPECT_TRUE(Utility::fuzzyCompare(M_SQRT1_2, state.amplitude(3).real()));
+    EXPECT_TRUE(compareVectors(Vector3D(0, 0, 0), state.blochVector(0)));
+    EXPECT_TRUE(compareVectors(Vector3D(0, 0, 0), state.blochVector(1)));
+    EXPECT_TRUE(Utility::fuzzyCompare(1., state.norm()));
+}
+
+TEST(StateVector, controlledStepEntangles) {
+    // H, then a CNOT as a CTRL and an X in one step
+    CircuitModel circuit(2, 2);
+    circuit.setCell(0, 0, {CircuitModel::H, 0});
+    circuit.setCell(0, 1, {CircuitModel::CTRL, 0});
+    circuit.setCell(1, 1, {CircuitModel::X, 0});
+
+    CircuitState state({Vector3D(0, 0, 1), Vector3D(0, 0, 1)}, circuit.hasControls());
+    ASSERT_TRUE(state.isJoint());
+    for (int s = 0; s < circuit.countOfSteps(); ++s) {
+        state.applyStep(circuit, s);
+    }
+    const StateVector *joint = state.jointState();
+    EXPECT_TRUE(Utility::fuzzyCompare(M_SQRT1_2, joint->amplitude(0).real()));
+    EXPECT_TRUE(Utility::fuzzyCompare(M_SQRT1_2, joint->amplitude(3).real()));
+    EXPECT_TRUE(compareVectors(Vector3D(0, 0, 0), state.blochVector(0)));
+    EXPECT_TRUE(compareVectors(Vector3D(0, 0, 0), state.blochVector(1)));
+}
+
+TEST(StateVector, productCircuitKeepsQubitsApart) {
+    const int    qubits = 8;
+    const int    steps = 20;
+    CircuitModel circuit(qubits, steps);
+    for (int s = 0; s < steps; ++s) {
+        for (int q = 0; q < qubits; ++q) {
+            quint8 gate = static_cast<quint8>((q * 7 + s * 3) % CircuitModel::CTRL);
+            circuit.setCell(q, s, {gate, Utility::random(0., 2 * M_PI)});
+        }
+    }
+    QVector<Vector3D> points;
+    for (int q = 0; q < qubits; ++q) {
+        points.append(
+            Vector::createSpike(Utility::random(0., M_PI), Utility::random(0., 2 * M_PI)).point);
+    }
+
+    CircuitState product(points, circuit.hasControls());
+    CircuitState joint(points, true);
+    EXPECT_FALSE(product.isJoint());
+    EXPECT_EQ(nullptr, product.jointState());
+    for (int s = 0; s < steps; ++s) {
+        product.applyStep(circuit, s);
+        joint.applyStep(circuit, s);
+    }
+    for (int q = 0; q < qubits; ++q) {
+        EXPECT_TRUE(compareVectors(joint.blochVector(q), product.blochVector(q))) << "qubit " << q;
+    }
+}
@@ -0,0 +1,129 @@
+// A Bloch sphere emulator program.
+// Copyright (C) 2022 Vasiliy Stephanov <baseoleph@gmail.com>
+
+// This program is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+#include "src/quantum/Operator.h"
+#include "src/quantum/Trace.h"
+#include "src/quantum/Vector.h"
+#include <gtest/gtest.h>
+
+TEST(Trace, runs) {
+    Vector v(0., 0.);
+    v.changeVector(Operator::rXRotate(v.getSpike(), M_PI / 2));
+    v.setAnimateState(true);
+    while (v.isNowAnimate()) {
+        v.takeStep();
+    }
+    EXPECT_EQ(1, v.getTrace().runs().size());
+    EXPECT_EQ(v.getTrace().countOfSegments() + 1, v.getTrace().size());
+
+    Trace trace = v.getTrace();
+    trace.append(Vector3D(1, 0, 0), Vector3D(0, 1, 0), Color::RED);
+    ASSERT_EQ(2, trace.runs().size());
+    EXPECT_EQ(v.getTrace().size(), trace.runs().last());
+
+    unsigned generation = trace.generation();
+    trace.clear();
+    EXPECT_TRUE(trace.isEmpty());
+    EXPECT_TRUE(trace.runs().isEmpty());
+    EXPECT_NE(generation, trace.generation());
+}
+
+TEST(Trace, mergeKeepsShape) {
+    TracePolicy saved = Trace::getPolicy();
+    Vector      v(M_PI / 3, 0.);
+    Path        path = Operator::rotate(v.getSpike(), Vector3D(0, 0, 1), 2 * M_PI);
+    v.changeVector(path);
+    v.setAnimateState(true);
+    while (v.isNowAnimate()) {
+        v.takeStep();
+    }
+
+    const Trace &trace = v.getTrace();
+    EXPECT_GT(path.size() - 1, trace.countOfSegments());
+    // Every frame stays close to the merged polyline
+    for (int i = 0; i < path.size(); ++i) {
+        Vector3D p = path.frame(i).point;
+        double   best = 1.;
+        for (int j = 1; j < trace.size(); ++j) {
+            Vector3D a(trace.vertices()[j - 1].x, trace.vertices()[j - 1].y,
+                       trace.vertices()[j - 1].z);
+            Vector3D b(trace.vertices()[j].x, trace.vertices()[j].y, trace.vertices()[j].z);
+            Vector3D ab = b - a;
+            double   t = qBound(0., Vector3D::dotProduct(p - a, ab) / ab.lengthSquared(), 1.);
+            best = qMin(best, (p - (a + t * ab)).length());
+        }
+        EXPECT_GE(saved.mergeTolerance + 1e-5, best) << "frame " << i;
+    }
+
+    TracePolicy exact = saved;
+    exact.mergeTolerance = 0;
+    Trace::setPolicy(exact);
+    Trace full;
+    for (int i = 1; i < path.size(); ++i) {
+        full.append(path.frame(i - 1).point, path.frame(i).point, Color::GRAY);
+    }
+    Trace::setPolicy(saved);
+    EXPECT_EQ(path.size() - 1, full.countOfSegments());
+    EXPECT_NEAR(full.length(), trace.length(), 0.01);
+}
+
+TEST(Trace, limit) {
+    TracePolicy saved = Trace::getPolicy();
+    TracePolicy limited = saved;
+    limited.mergeTolerance = 0;
+    limited.maxVertices = 100;
+    Trace::setPolicy(limited);
+
+    Trace    trace;
+    Vector3D p(1, 0, 0);
+    unsigned generation = trace.generation();
+    for (int i = 0; i < 1000; ++i) {
+        // A new run every 30 segments
+        Vector3D from = i % 30 == 0 ? Vector3D(0, 0, 1) : p;
+        p = Vector3D(std::cos(i * 0.01), std::sin(i * 0.01), 0);
+        trace.append(from, p, Color::GRAY);
+        EXPECT_GE(limited.maxVertices, trace.size());
+    }
+    Trace::setPolicy(saved);
+
+    EXPECT_NE(generation, trace.generation());
+    ASSERT_FALSE(trace.runs().isEmpty());
+    EXPECT_EQ(0, trace.runs().first());
+    for (int i = 1; i < trace.runs().size(); ++i) {
+        EXPECT_LT(trace.runs()[i - 1], trace.runs()[i]);
+    }
+    EXPECT_FLOAT_EQ(static_cast<float>(p.x()), trace.vertices().last().x);
+}
+
+TEST(Trace, standingStillKeepsMemory) {
+    Trace    trace;
+    Vector3D pole(0, 0, 1);
+    trace.append(Vector3D(1, 0, 0), pole, Color::GRAY);
+    int bytes = trace.countOfBytes();
+    for (int i = 0; i < 10000; ++i) {
+        trace.append(pole, pole, Color::GRAY);
+    }
+    EXPECT_EQ(bytes, trace.countOfBytes());
+    EXPECT_EQ(1, trace.countOfSegments());
+
+    // Slow moves along one line are merged, but only so many into one segment
+    Trace line;
+    for (int i = 1; i <= 10000; ++i) {
+        line.append(Vector3D(0, 0, (i - 1) * 1e-5), Vector3D(0, 0, i * 1e-5), Color::GRAY);
+    }
+    EXPECT_GT(10000, line.countOfSegments());
+    EXPECT_GT(50 * 1024, line.countOfBytes());
+}